@@ -0,0 +1,252 @@
+/**
+ * @file      carena.h
+ * @version   1.0
+ * @brief     CArena header-only region allocator for C89 language
+ * @date      Sat Oct 17 01:35:17 2026
+ * @author    Michele Pes
+ * @copyright BSD-3-Clause
+ *
+ * This file offers an arena (region) allocator: memory is taken from large
+ * blocks by bumping a pointer, and it is never released one allocation at a
+ * time. carena_reset() reclaims all the allocations at once, keeping a block
+ * for the next round, and carena_destroy() releases the blocks.
+ * Vectors and lists can be initialized against an arena, see
+ * cvector_init_arena() and clist_init_arena() (enabled by defining
+ * #CVECTOR_ARENA and #CLIST_ARENA): their growth and their nodes are then
+ * pointer bumps, and destroying them releases no memory.
+ * Like malloc, allocation functions return NULL when memory is not available
+ */
+
+#ifndef CARENA_H_
+#define CARENA_H_
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def CARENA_BLOCK_SIZE
+ * The default size in \b bytes of the blocks allocated by an arena, used when
+ * zero is passed to carena_init()
+ */
+#ifndef CARENA_BLOCK_SIZE
+#define CARENA_BLOCK_SIZE 65536U
+#endif
+
+/**
+ * @def CARENA_ALIGN
+ * The alignment of the pointers returned by an arena. It must be a power of
+ * two, large enough for any type stored in the arena
+ */
+#ifndef CARENA_ALIGN
+#define CARENA_ALIGN 16U
+#endif
+
+typedef struct vnut_arena_block_t {
+    struct vnut_arena_block_t* next;
+    size_t size;
+} vnut_arena_block_t;
+
+#define VNUT_ARENA_ROUND(x) \
+    (((x) + (CARENA_ALIGN - 1U)) & ~(size_t)(CARENA_ALIGN - 1U))
+
+#define VNUT_ARENA_HEADER VNUT_ARENA_ROUND(sizeof(vnut_arena_block_t))
+
+typedef struct vnut_arena_t {
+    vnut_arena_block_t* blocks;
+    unsigned char* cur;
+    unsigned char* end;
+    unsigned char* last;
+    unsigned char* buffer;
+    size_t buffer_size;
+    size_t block_size;
+} carena_t;
+
+/**
+ * @brief Initialize an arena. No memory is allocated until the first
+ *        allocation
+ * @param[in] arena The arena to initialize
+ * @param[in] block_size The size in \b bytes of the blocks to allocate, or
+ *            zero for #CARENA_BLOCK_SIZE. Larger allocations get a block of
+ *            their own
+ */
+static void carena_init(carena_t* arena, size_t block_size) {
+    arena->blocks = NULL;
+    arena->cur = arena->end = arena->last = NULL;
+    arena->buffer = NULL;
+    arena->buffer_size = 0U;
+    arena->block_size = (block_size > 0U) ? block_size : CARENA_BLOCK_SIZE;
+}
+
+/**
+ * @brief Initialize an arena serving allocations from a user buffer first
+ * @param[in] arena The arena to initialize
+ * @param[in] buffer The memory used before allocating any block. It is never
+ *            freed by the arena
+ * @param[in] size The size in \b bytes of \a buffer
+ * @param[in] block_size The size in \b bytes of the blocks to allocate when
+ *            \a buffer is full. Pass zero to never allocate memory: in this
+ *            case allocations fail when \a buffer is full
+ */
+static void carena_init_ext(carena_t* arena,
+                            void* buffer,
+                            size_t size,
+                            size_t block_size)
+{
+    const size_t skew = (size_t)buffer & (CARENA_ALIGN - 1U);
+    const size_t pad = (skew > 0U) ? (CARENA_ALIGN - skew) : 0U;
+
+    arena->blocks = NULL;
+    arena->buffer = (unsigned char*)buffer + ((pad < size) ? pad : size);
+    arena->buffer_size = (pad < size) ? (size - pad) : 0U;
+    arena->cur = arena->buffer;
+    arena->end = arena->buffer + arena->buffer_size;
+    arena->last = NULL;
+    arena->block_size = block_size;
+}
+
+/**
+ * @brief Allocate memory from an arena
+ * @param[in] arena The arena
+ * @param[in] size The size in \b bytes to allocate
+ * @return A pointer aligned to #CARENA_ALIGN, or NULL if not enough memory
+ * @note Allocations are never released one by one, see carena_reset()
+ */
+static void* carena_alloc(carena_t* arena, size_t size) {
+    const size_t rounded = VNUT_ARENA_ROUND((size > 0U) ? size : 1U);
+    unsigned char* p = NULL;
+
+    if ((rounded >= size) && (rounded <= (size_t)(arena->end - arena->cur))) {
+        p = arena->cur;
+        arena->cur += rounded;
+        arena->last = p;
+    }
+    else if ((arena->block_size > 0U)
+             && (rounded <= ((size_t)-1 - VNUT_ARENA_HEADER)))
+    {
+        const int own = (rounded > (arena->block_size / 2U)) ? 1 : 0;
+        const size_t data = (own != 0) ? rounded
+                                       : VNUT_ARENA_ROUND(arena->block_size);
+        vnut_arena_block_t* const b =
+            (vnut_arena_block_t*)malloc(VNUT_ARENA_HEADER + data);
+
+        if (b != NULL) {
+            p = (unsigned char*)b + VNUT_ARENA_HEADER;
+            b->size = data;
+            if ((own != 0) && (arena->blocks != NULL)) {
+                /* keep bumping the current block */
+                b->next = arena->blocks->next;
+                arena->blocks->next = b;
+            }
+            else {
+                b->next = arena->blocks;
+                arena->blocks = b;
+                arena->cur = p + rounded;
+                arena->end = p + data;
+                arena->last = p;
+            }
+        }
+    }
+
+    return p;
+}
+
+/**
+ * @brief Resize an allocation of an arena
+ * @param[in] arena The arena
+ * @param[in] p The allocation to resize. Can be NULL, in this case the
+ *            function is equivalent to carena_alloc()
+ * @param[in] old_size The size in \b bytes of \a p
+ * @param[in] new_size The new size in \b bytes
+ * @return The resized allocation, or NULL if not enough memory. In the latter
+ *         case \a p is left untouched
+ * @note The last allocation of the arena grows and shrinks in place while
+ *       there is room in its block. Other allocations are copied to a new
+ *       one, and their old memory is reclaimed only by carena_reset()
+ */
+static void* carena_realloc(carena_t* arena,
+                            void* p,
+                            size_t old_size,
+                            size_t new_size)
+{
+    unsigned char* const q = (unsigned char*)p;
+    void* r = NULL;
+
+    if ((q != NULL) && (q == arena->last)) {
+        const size_t rounded = VNUT_ARENA_ROUND((new_size > 0U) ? new_size
+                                                                : 1U);
+        if ((rounded >= new_size)
+            && (rounded <= (size_t)(arena->end - q)))
+        {
+            arena->cur = q + rounded;
+            r = q;
+        }
+    }
+    else if ((q != NULL) && (new_size <= old_size)) {
+        r = q;
+    }
+
+    if (r == NULL) {
+        r = carena_alloc(arena, new_size);
+        if ((r != NULL) && (q != NULL)) {
+            memcpy(r, q, (old_size < new_size) ? old_size : new_size);
+        }
+    }
+
+    return r;
+}
+
+/**
+ * @brief Reclaim all the allocations of an arena at once
+ * @param[in] arena The arena to reset
+ * @note The most recent block is kept for the next allocations (or the user
+ *       buffer, for arenas initialized by carena_init_ext()), all the other
+ *       blocks are freed
+ * @warning All the containers using the arena must be considered destroyed
+ */
+static void carena_reset(carena_t* arena) {
+    vnut_arena_block_t* b = arena->blocks;
+    vnut_arena_block_t* keep = NULL;
+
+    if ((b != NULL) && (arena->buffer == NULL)) {
+        keep = b;
+        b = b->next;
+        keep->next = NULL;
+        arena->cur = (unsigned char*)keep + VNUT_ARENA_HEADER;
+        arena->end = arena->cur + keep->size;
+    }
+    else {
+        arena->cur = arena->buffer;
+        arena->end = arena->buffer + arena->buffer_size;
+    }
+
+    while (b != NULL) {
+        vnut_arena_block_t* const next = b->next;
+        free(b);
+        b = next;
+    }
+
+    arena->blocks = keep;
+    arena->last = NULL;
+}
+
+/**
+ * @brief Destroy an arena, freeing all its blocks
+ * @param[in] arena The arena to destroy
+ * @warning All the containers using the arena must be considered destroyed
+ */
+static void carena_destroy(carena_t* arena) {
+    carena_reset(arena);
+    free(arena->blocks);
+    arena->blocks = NULL;
+    arena->cur = arena->end = arena->buffer;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
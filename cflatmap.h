@@ -0,0 +1,337 @@
+/**
+ * @file      cflatmap.h
+ * @version   1.0
+ * @brief     CFlatMap header-only sorted map library for C89 language
+ * @date      Sat Oct 17 01:17:00 2026
+ * @author    Michele Pes
+ * @copyright BSD-3-Clause
+ *
+ * This file offers a flat sorted map (and set) built on top of CVector.
+ * Entries are stored contiguously in a single cvector, each entry being the
+ * key immediately followed by its value, and the vector is always kept sorted
+ * by key. Lookups are binary searches on contiguous memory, so for small and
+ * medium maps this container beats pointer-based trees both on memory and
+ * lookup time. Inserting many entries at once should be done with
+ * cflatmap_build() or cflatmap_merge(), that cost a single pass instead of one
+ * memmove per entry.
+ * A set is simply a map whose value size is zero.
+ * CFlatMap follows the CVector philosophy: no checks are done and errors
+ * related to memory are reported through the cvector error callback, see
+ * cvector_set_callback()
+ */
+
+#ifndef CFLATMAP_H_
+#define CFLATMAP_H_
+
+#include <stdlib.h>
+#include "cvector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    cvector_t v;
+    cv_ui ks;
+    cvector_cmp_t cmp;
+} cflatmap_t;
+
+/**
+ * @brief Initialize a map using dynamic memory
+ * @param[in] map A pointer to the map to initialize
+ * @param[in] key_size The size of the keys (ex.: sizeof(int))
+ * @param[in] value_size The size of the values. Pass zero to obtain a set
+ * @param[in] num_elems The number of entries to allocate, see cvector_init()
+ * @param[in] cmp The function comparing two keys
+ * @note This function fails as cvector_init() does. In that case the error
+ *       callback is called
+ */
+static void cflatmap_init(cflatmap_t* map,
+                          cv_ui key_size,
+                          cv_ui value_size,
+                          cv_ui num_elems,
+                          cvector_cmp_t cmp)
+{
+    cvector_init(&map->v, key_size + value_size, num_elems, CVECTOR_DATA);
+    map->ks = key_size;
+    map->cmp = cmp;
+}
+
+/**
+ * @brief Initialize an empty map with passed memory space. No dynamic memory
+ *        is required
+ * @param[in] map A pointer to the map to initialize
+ * @param[in] buffer A pointer to the memory the map will use. Be sure to have
+ *            at least <a>(key_size+value_size)*reserved</a> bytes in buffer
+ * @param[in] key_size The size of the keys (ex.: sizeof(int))
+ * @param[in] value_size The size of the values. Pass zero to obtain a set
+ * @param[in] reserved The maximum number of entries of the map
+ * @param[in] cmp The function comparing two keys
+ * @sa cvector_init_ext()
+ */
+static void cflatmap_init_ext(cflatmap_t* map,
+                              void* buffer,
+                              cv_ui key_size,
+                              cv_ui value_size,
+                              cv_ui reserved,
+                              cvector_cmp_t cmp)
+{
+    cvector_init_ext(&map->v, buffer, key_size + value_size, reserved, 0U,
+                     CVECTOR_DATA);
+    map->ks = key_size;
+    map->cmp = cmp;
+}
+
+/**
+ * @brief Destroy a map, deallocating its entries
+ * @param[in] map A pointer to the map to destroy
+ */
+static void cflatmap_destroy(cflatmap_t* map) {
+    cvector_destroy(&map->v);
+}
+
+/**
+ * @brief Remove all entries from the map
+ * @param[in] map A pointer to the map to clear
+ */
+static void cflatmap_clear(cflatmap_t* map) {
+    cvector_clear(&map->v);
+}
+
+/**
+ * @brief Return the number of entries of the map
+ * @param[in] map A constant pointer to the map
+ * @return The number of entries
+ */
+static cv_ui cflatmap_size(const cflatmap_t* map) {
+    return map->v.n;
+}
+
+/**
+ * @brief Tell if map is empty
+ * @param[in] map A constant pointer to the map
+ * @return Non-zero if map is empty, zero otherwise
+ */
+static int cflatmap_empty(const cflatmap_t* map) {
+    return (map->v.n == 0U) ? 1 : 0;
+}
+
+/**
+ * @brief Return a pointer to the key of the entry at index \a idx
+ * @param[in] map A pointer to the map
+ * @param[in] idx The index of the entry, must be less than the map size
+ * @return A pointer to the key. Keys must never be modified through it
+ * @note Entries are sorted by key, so iterating on indexes from zero to
+ *       cflatmap_size() visits the keys in ascending order
+ */
+static void* cflatmap_key(cflatmap_t* map, cv_ui idx) {
+    return map->v.p + (idx * map->v.t);
+}
+
+/**
+ * @brief Return a pointer to the value of the entry at index \a idx
+ * @param[in] map A pointer to the map
+ * @param[in] idx The index of the entry, must be less than the map size
+ * @return A pointer to the value
+ */
+static void* cflatmap_value(cflatmap_t* map, cv_ui idx) {
+    return map->v.p + (idx * map->v.t) + map->ks;
+}
+
+/**
+ * @brief Return the index of the first entry whose key is not less than \a key
+ * @param[in] map A constant pointer to the map
+ * @param[in] key A pointer to the key to search
+ * @return The index of the entry, or the map size if all keys are less than
+ *         \a key
+ */
+static cv_ui cflatmap_lower_bound(const cflatmap_t* map, const void* key) {
+    const cv_uchar* const p = map->v.p;
+    const cv_ui t = map->v.t;
+    cv_ui lo = 0U;
+    cv_ui len = map->v.n;
+
+    while (len > 0U) {
+        const cv_ui half = len / 2U;
+        if ((*map->cmp)(p + ((lo + half) * t), key) < 0) {
+            lo += half + 1U;
+            len -= half + 1U;
+        }
+        else {
+            len = half;
+        }
+    }
+
+    return lo;
+}
+
+/**
+ * @brief Find the entry with given key
+ * @param[in] map A constant pointer to the map
+ * @param[in] key A pointer to the key to search
+ * @return The index of the entry or the map size if \a key is not present
+ */
+static cv_ui cflatmap_find(const cflatmap_t* map, const void* key) {
+    const cv_ui idx = cflatmap_lower_bound(map, key);
+    return ((idx < map->v.n)
+            && ((*map->cmp)(map->v.p + (idx * map->v.t), key) == 0))
+           ? idx : map->v.n;
+}
+
+/**
+ * @brief Return the value associated to given key
+ * @param[in] map A pointer to the map
+ * @param[in] key A pointer to the key to search
+ * @return A pointer to the value or NULL if \a key is not present
+ */
+static void* cflatmap_get(cflatmap_t* map, const void* key) {
+    const cv_ui idx = cflatmap_find(map, key);
+    return (idx < map->v.n) ? cflatmap_value(map, idx) : NULL;
+}
+
+/**
+ * @brief Insert an entry, or replace the value of an existing one
+ * @param[in] map A pointer to the map
+ * @param[in] key A pointer to the key of the entry
+ * @param[in] value A pointer to the value of the entry. Can be NULL to leave
+ *            the value uninitialized (or untouched if the key is present)
+ * @return The index of the entry
+ * @note When a new key is inserted, the following entries are moved. To
+ *       insert many entries, see cflatmap_merge() and cflatmap_build()
+ */
+static cv_ui cflatmap_insert(cflatmap_t* map,
+                             const void* key,
+                             const void* value)
+{
+    const cv_ui idx = cflatmap_lower_bound(map, key);
+    const cv_ui vs = map->v.t - map->ks;
+    const cv_ui n = map->v.n;
+    int ok = 1;
+
+    if ((idx == n) || ((*map->cmp)(map->v.p + (idx * map->v.t), key) != 0)) {
+        cvector_insert_n(&map->v, idx, 1U, NULL, 1);
+        ok = (map->v.n > n) ? 1 : 0;
+        if (ok != 0) {
+            memcpy(map->v.p + (idx * map->v.t), key, map->ks);
+        }
+    }
+
+    if ((ok != 0) && (value != NULL) && (vs > 0U)) {
+        memcpy(cflatmap_value(map, idx), value, vs);
+    }
+
+    return idx;
+}
+
+/**
+ * @brief Remove the entry with given key
+ * @param[in] map A pointer to the map
+ * @param[in] key A pointer to the key of the entry to remove
+ * @return Non-zero if the entry was present and has been removed, zero
+ *         otherwise
+ */
+static int cflatmap_erase(cflatmap_t* map, const void* key) {
+    const cv_ui idx = cflatmap_find(map, key);
+    const int found = (idx < map->v.n) ? 1 : 0;
+    if (found != 0) {
+        cvector_erase(&map->v, idx, 1U);
+    }
+    return found;
+}
+
+/**
+ * @brief Replace the content of the map with unsorted entries
+ * @param[in] map A pointer to the map
+ * @param[in] entries The entries, each one being a key immediately followed by
+ *            its value
+ * @param[in] len The number of entries
+ * @note Entries are copied, sorted and duplicated keys are removed in a single
+ *       pass. When a key is duplicated, which of its entries survives is
+ *       unspecified
+ */
+static void cflatmap_build(cflatmap_t* map, const void* entries, cv_ui len) {
+    cvector_t* const pv = &map->v;
+
+    cvector_clear(pv);
+    cvector_insert_n(pv, 0U, len, entries, 0);
+
+    if ((pv->n == len) && (len > 1U)) {
+        const cv_ui t = pv->t;
+        cv_uchar* const p = pv->p;
+        cv_ui i, w = 1U;
+
+        qsort(p, len, t, map->cmp);
+
+        for (i = 1U; i < len; i++) {
+            if ((*map->cmp)(p + ((w - 1U) * t), p + (i * t)) != 0) {
+                if (w != i) {
+                    memcpy(p + (w * t), p + (i * t), t);
+                }
+                w++;
+            }
+        }
+
+        pv->n = w;
+        pv->f = p + (w * t);
+    }
+}
+
+/**
+ * @brief Merge a batch of sorted entries into the map
+ * @param[in] map A pointer to the map
+ * @param[in] entries The entries, each one being a key immediately followed by
+ *            its value. They must be sorted by key and without duplicates
+ * @param[in] len The number of entries
+ * @note The merge is done in place in a single backward pass, so every entry
+ *       is moved at most once. When a key is already present, its value is
+ *       replaced by the one in \a entries
+ * @note The map must have room for its size plus \a len entries, otherwise it
+ *       grows (or the error callback is called) even if some keys are
+ *       already present
+ */
+static void cflatmap_merge(cflatmap_t* map, const void* entries, cv_ui len) {
+    cvector_t* const pv = &map->v;
+    const cv_ui m = pv->n;
+
+    cvector_reserve(pv, m + len);
+
+    if ((len > 0U) && (pv->m >= (m + len))) {
+        const cv_uchar* const batch = (const cv_uchar*)entries;
+        const cv_ui t = pv->t;
+        cv_uchar* const p = pv->p;
+        cv_ui i = m, j = len, w = m + len;
+
+        while (j > 0U) {
+            const cv_uchar* const b = batch + ((j - 1U) * t);
+            const int c = (i > 0U) ? (*map->cmp)(p + ((i - 1U) * t), b) : -1;
+
+            w--;
+            if (c > 0) {
+                i--;
+                if (w != i) {
+                    memcpy(p + (w * t), p + (i * t), t);
+                }
+            }
+            else {
+                j--;
+                memcpy(p + (w * t), b, t);
+                if (c == 0) {
+                    i--;
+                }
+            }
+        }
+
+        if (w != i) {
+            memmove(p + (i * t), p + (w * t), ((m + len) - w) * t);
+        }
+
+        pv->n = (m + len) - (w - i);
+        pv->f = p + (pv->n * t);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,235 @@
+/*
+clang -Ofast -och.exe -DCHASHMAP ch_bench.c
+clang -Ofast -ouh.exe ch_bench.c
+
+gcc -Ofast -och -DCHASHMAP ch_bench.c
+gcc -Ofast -ouh ch_bench.c
+
+cl /O2 /Fech -DCHASHMAP ch_bench.c
+cl /O2 /Feuh ch_bench.c
+
+compare the times printed by both exe on your env. The second one uses a
+simple chaining hash table, with one malloc per entry. Both hash the keys
+with the identity and mix them: the last test uses keys whose low bits are
+all zero, which a weak mix puts in the same few groups
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifdef CHASHMAP
+#include "chashmap.h"
+#else
+typedef struct entry {
+    struct entry* next;
+    size_t key;
+    size_t value;
+} entry_t;
+
+typedef struct {
+    entry_t** buckets;
+    size_t mask;
+    size_t size;
+} table_t;
+
+static size_t table_bucket(const table_t* t, size_t key) {
+    /* the same finalizer as chashmap */
+    key ^= (key >> 16) >> 17;
+    key *= (((size_t)0xFF51AFD7UL << 16) << 16) | 0xED558CCDUL;
+    key ^= (key >> 16) >> 17;
+    key *= (((size_t)0xC4CEB9FEUL << 16) << 16) | 0x1A85EC53UL;
+    key ^= (key >> 16) >> 17;
+    return key & t->mask;
+}
+
+static void table_init(table_t* t) {
+    t->mask = 15;
+    t->size = 0;
+    t->buckets = (entry_t**)calloc(t->mask + 1U, sizeof(entry_t*));
+}
+
+static void table_destroy(table_t* t) {
+    size_t i;
+    for (i = 0; i <= t->mask; i++) {
+        entry_t* e = t->buckets[i];
+        while (e != NULL) {
+            entry_t* const next = e->next;
+            free(e);
+            e = next;
+        }
+    }
+    free(t->buckets);
+}
+
+static size_t* table_find(table_t* t, size_t key) {
+    entry_t* e = t->buckets[table_bucket(t, key)];
+    while ((e != NULL) && (e->key != key)) {
+        e = e->next;
+    }
+    return (e != NULL) ? &e->value : NULL;
+}
+
+static void table_insert(table_t* t, size_t key, size_t value) {
+    size_t* const p = table_find(t, key);
+    if (p != NULL) {
+        *p = value;
+    }
+    else {
+        entry_t* const e = (entry_t*)malloc(sizeof(entry_t));
+        size_t b;
+
+        if (t->size == t->mask) {
+            entry_t** const old = t->buckets;
+            const size_t old_len = t->mask + 1U;
+            size_t i;
+
+            t->mask = (old_len * 2U) - 1U;
+            t->buckets = (entry_t**)calloc(t->mask + 1U, sizeof(entry_t*));
+            for (i = 0; i < old_len; i++) {
+                entry_t* n = old[i];
+                while (n != NULL) {
+                    entry_t* const next = n->next;
+                    b = table_bucket(t, n->key);
+                    n->next = t->buckets[b];
+                    t->buckets[b] = n;
+                    n = next;
+                }
+            }
+            free(old);
+        }
+
+        b = table_bucket(t, key);
+        e->key = key;
+        e->value = value;
+        e->next = t->buckets[b];
+        t->buckets[b] = e;
+        t->size++;
+    }
+}
+#endif
+
+#define NUM_KEYS (1 << 22)
+#define LOOKUP_LOOP (NUM_KEYS * 4)
+#define NUM_STRUCT_KEYS (1 << 20)
+
+#ifdef CHASHMAP
+static cv_ui hash_key(const void* key) {
+    return *(const size_t*)key;
+}
+#endif
+
+static size_t make_key(size_t i) {
+    return (i * 2654435761UL) | 1U;
+}
+
+/* distinct keys with only zeros below the top 20 bits */
+static size_t make_struct_key(size_t i) {
+    return i << ((sizeof(size_t) * 8U) - 20U);
+}
+
+int main(void)
+{
+#ifdef CHASHMAP
+    chashmap_t map;
+#else
+    table_t table;
+#endif
+    size_t i, found = 0, sum = 0;
+    clock_t start;
+
+#ifdef CHASHMAP
+    chashmap_init(&map, sizeof(size_t), sizeof(size_t), CVECTOR_DEFAULT_LEN,
+                  &hash_key);
+#else
+    table_init(&table);
+#endif
+
+    start = clock();
+    for (i = 0; i < NUM_KEYS; i++) {
+        const size_t key = make_key(i);
+#ifdef CHASHMAP
+        chashmap_insert(&map, &key, &i);
+#else
+        table_insert(&table, key, i);
+#endif
+    }
+    printf("insert: %.3f s\n", (double)(clock() - start) / CLOCKS_PER_SEC);
+
+    srand((unsigned int)time(NULL));
+
+    start = clock();
+    for (i = 0; i < LOOKUP_LOOP; i++) {
+        const size_t key = make_key((size_t)rand() % NUM_KEYS);
+#ifdef CHASHMAP
+        const size_t* const p = (const size_t*)chashmap_find(&map, &key);
+#else
+        const size_t* const p = table_find(&table, key);
+#endif
+        if (p != NULL) {
+            sum += *p;
+            found++;
+        }
+    }
+    printf("hit:    %.3f s\n", (double)(clock() - start) / CLOCKS_PER_SEC);
+
+    start = clock();
+    for (i = 0; i < LOOKUP_LOOP; i++) {
+        const size_t key = make_key((size_t)rand() % NUM_KEYS) + 1U;
+#ifdef CHASHMAP
+        const size_t* const p = (const size_t*)chashmap_find(&map, &key);
+#else
+        const size_t* const p = table_find(&table, key);
+#endif
+        if (p != NULL) {
+            puts("impossible");
+            exit(-1);
+        }
+    }
+    printf("miss:   %.3f s\n", (double)(clock() - start) / CLOCKS_PER_SEC);
+
+    if (found != LOOKUP_LOOP) {
+        puts("impossible");
+        exit(-1);
+    }
+
+#ifdef CHASHMAP
+    chashmap_destroy(&map);
+    chashmap_init(&map, sizeof(size_t), sizeof(size_t), CVECTOR_DEFAULT_LEN,
+                  &hash_key);
+#else
+    table_destroy(&table);
+    table_init(&table);
+#endif
+
+    start = clock();
+    for (i = 0; i < NUM_STRUCT_KEYS; i++) {
+        const size_t key = make_struct_key(i);
+#ifdef CHASHMAP
+        chashmap_insert(&map, &key, &i);
+#else
+        table_insert(&table, key, i);
+#endif
+    }
+    for (i = 0; i < NUM_STRUCT_KEYS; i++) {
+        const size_t key = make_struct_key(i);
+#ifdef CHASHMAP
+        const size_t* const p = (const size_t*)chashmap_find(&map, &key);
+#else
+        const size_t* const p = table_find(&table, key);
+#endif
+        if ((p == NULL) || (*p != i)) {
+            puts("impossible");
+            exit(-1);
+        }
+    }
+    printf("struct: %.3f s\n", (double)(clock() - start) / CLOCKS_PER_SEC);
+
+#ifdef CHASHMAP
+    chashmap_destroy(&map);
+#else
+    table_destroy(&table);
+#endif
+
+    return (sum == 0U) ? 1 : 0;
+}
@@ -0,0 +1,565 @@
+/**
+ * @file      chashmap.h
+ * @version   1.0
+ * @brief     CHashMap header-only hash table library for C89 language
+ * @date      Sat Oct 17 01:20:44 2026
+ * @author    Michele Pes
+ * @copyright BSD-3-Clause
+ *
+ * This file offers an open-addressing hash table built on top of CVector.
+ * Keys and values have a fixed size decided at init time, as the type size of
+ * a cvector. The table uses the SwissTable scheme: one control byte per slot
+ * holds 7 bits of the hash of the stored key (or marks the slot as empty or
+ * deleted), and control bytes are probed in groups of #CHASHMAP_GROUP, all
+ * compared at once with SIMD instructions when available. So most lookups
+ * touch one group of control bytes and one slot only.
+ * Like cvector, the table can use dynamic memory or a static buffer, see
+ * chashmap_init_ext(), and memory errors are reported through the cvector
+ * error callback, see cvector_set_callback(). No other checks are done
+ */
+
+#ifndef CHASHMAP_H_
+#define CHASHMAP_H_
+
+#include "cvector.h"
+
+#if !defined(CHASHMAP_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define CHASHMAP_SSE2
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef DOXYGEN_ONLY
+/**
+ * @def CHASHMAP_NO_SIMD
+ * Define this macro \b before including chashmap.h to probe control bytes
+ * with plain C code even when SSE2 is available
+ */
+#define CHASHMAP_NO_SIMD
+#endif
+
+/**
+ * @def CHASHMAP_GROUP
+ * The number of control bytes probed at once. Capacities are always power of
+ * two multiples of this value
+ */
+#define CHASHMAP_GROUP 16U
+
+/**
+ * @def CHASHMAP_BUFFER_SIZE
+ * The number of bytes required by chashmap_init_ext() for a table of
+ * \a capacity slots, whose keys and values have size \a ks and \a vs
+ */
+#define CHASHMAP_BUFFER_SIZE(capacity, ks, vs) \
+    ((capacity) * (1U + (ks) + (vs)))
+
+#define CHASHMAP_EMPTY   ((cv_uchar)0x80U)
+#define CHASHMAP_DELETED ((cv_uchar)0xFEU)
+
+/**
+ * @typedef chashmap_hash_t
+ * Prototype of the hash function of keys. The returned value is further mixed
+ * by the table, so also a poor hash (like the identity on integers) can be used
+ */
+typedef cv_ui (*chashmap_hash_t)(const void* key);
+
+typedef struct {
+    cvector_t ctrl;
+    cvector_t slots;
+    cv_ui ks;
+    cv_ui size;
+    cv_ui left;
+    chashmap_hash_t hash;
+} chashmap_t;
+
+#define VNUT_HM_K64(hi, lo) ((((cv_ui)(hi) << 16U) << 16U) | (cv_ui)(lo))
+
+/* the finalizer of MurmurHash3: every bit of the result depends on every bit
+   of h, so keys differing only in their high bits still spread over all the
+   groups (the group is taken from the low bits, the H2 from the top ones) */
+static cv_ui vnut_hm_mix(cv_ui h) {
+    if (sizeof(cv_ui) > 4U) {
+        h ^= (h >> 16U) >> 17U;
+        h *= VNUT_HM_K64(0xFF51AFD7UL, 0xED558CCDUL);
+        h ^= (h >> 16U) >> 17U;
+        h *= VNUT_HM_K64(0xC4CEB9FEUL, 0x1A85EC53UL);
+        h ^= (h >> 16U) >> 17U;
+    }
+    else {
+        h ^= h >> 16U;
+        h *= (cv_ui)0x85EBCA6BUL;
+        h ^= h >> 13U;
+        h *= (cv_ui)0xC2B2AE35UL;
+        h ^= h >> 16U;
+    }
+    return h;
+}
+
+static cv_uchar vnut_hm_h2(cv_ui h) {
+    return (cv_uchar)((h >> ((sizeof(cv_ui) * 8U) - 7U)) & 0x7FU);
+}
+
+static unsigned int vnut_hm_ctz(unsigned int mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int)__builtin_ctz(mask);
+#else
+    unsigned int n = 0U;
+    while ((mask & 1U) == 0U) {
+        mask >>= 1U;
+        n++;
+    }
+    return n;
+#endif
+}
+
+static unsigned int vnut_hm_match(const cv_uchar* g, cv_uchar c) {
+#ifdef CHASHMAP_SSE2
+    const __m128i v = _mm_loadu_si128((const __m128i*)g);
+    return (unsigned int)_mm_movemask_epi8(
+        _mm_cmpeq_epi8(v, _mm_set1_epi8((char)c)));
+#else
+    unsigned int i, mask = 0U;
+    for (i = 0U; i < CHASHMAP_GROUP; i++) {
+        mask |= (unsigned int)(g[i] == c) << i;
+    }
+    return mask;
+#endif
+}
+
+static unsigned int vnut_hm_match_free(const cv_uchar* g) {
+#ifdef CHASHMAP_SSE2
+    return (unsigned int)_mm_movemask_epi8(
+        _mm_loadu_si128((const __m128i*)g));
+#else
+    unsigned int i, mask = 0U;
+    for (i = 0U; i < CHASHMAP_GROUP; i++) {
+        mask |= (unsigned int)(g[i] >> 7U) << i;
+    }
+    return mask;
+#endif
+}
+
+static int vnut_hm_equal(const void* a, const void* b, cv_ui ks) {
+    int eq;
+    if (ks == sizeof(cv_ui)) {
+        cv_ui x, y;
+        memcpy(&x, a, sizeof(cv_ui));
+        memcpy(&y, b, sizeof(cv_ui));
+        eq = (x == y) ? 1 : 0;
+    }
+    else if (ks == sizeof(unsigned int)) {
+        unsigned int x, y;
+        memcpy(&x, a, sizeof(unsigned int));
+        memcpy(&y, b, sizeof(unsigned int));
+        eq = (x == y) ? 1 : 0;
+    }
+    else {
+        eq = (memcmp(a, b, ks) == 0) ? 1 : 0;
+    }
+    return eq;
+}
+
+static cv_ui vnut_hm_max_load(cv_ui capacity) {
+    return capacity - (capacity / 8U);
+}
+
+static void vnut_hm_reset(chashmap_t* map) {
+    const cv_ui cap = map->ctrl.n;
+    memset(map->ctrl.p, CHASHMAP_EMPTY, cap);
+    map->size = 0U;
+    map->left = vnut_hm_max_load(cap);
+}
+
+static cv_ui vnut_hm_find_free(const chashmap_t* map, cv_ui h) {
+    const cv_uchar* const ctrl = map->ctrl.p;
+    const cv_ui mask = (map->ctrl.n / CHASHMAP_GROUP) - 1U;
+    cv_ui g = h & mask;
+    cv_ui step = 0U;
+    unsigned int m;
+
+    while ((m = vnut_hm_match_free(ctrl + (g * CHASHMAP_GROUP))) == 0U) {
+        step++;
+        g = (g + step) & mask;
+    }
+
+    return (g * CHASHMAP_GROUP) + vnut_hm_ctz(m);
+}
+
+static cv_ui vnut_hm_find(const chashmap_t* map, const void* key, cv_ui h) {
+    const cv_uchar* const ctrl = map->ctrl.p;
+    const cv_uchar* const slots = map->slots.p;
+    const cv_ui t = map->slots.t;
+    const cv_ui cap = map->ctrl.n;
+    const cv_ui mask = (cap / CHASHMAP_GROUP) - 1U;
+    const cv_uchar h2 = vnut_hm_h2(h);
+    cv_ui g = h & mask;
+    cv_ui step = 0U;
+
+    for (;;) {
+        const cv_uchar* const group = ctrl + (g * CHASHMAP_GROUP);
+        unsigned int m = vnut_hm_match(group, h2);
+
+        while (m != 0U) {
+            const cv_ui i = (g * CHASHMAP_GROUP) + vnut_hm_ctz(m);
+            if (vnut_hm_equal(slots + (i * t), key, map->ks) != 0) {
+                return i;
+            }
+            m &= m - 1U;
+        }
+
+        if ((vnut_hm_match(group, CHASHMAP_EMPTY) != 0U) || (step > mask)) {
+            return cap;
+        }
+
+        step++;
+        g = (g + step) & mask;
+    }
+}
+
+static void vnut_hm_drop_deleted(chashmap_t* map) {
+    cv_uchar* const ctrl = map->ctrl.p;
+    cv_uchar* const slots = map->slots.p;
+    const cv_ui t = map->slots.t;
+    const cv_ui cap = map->ctrl.n;
+    cv_ui i;
+
+    for (i = 0U; i < cap; i++) {
+        ctrl[i] = ((ctrl[i] & 0x80U) == 0U) ? CHASHMAP_DELETED
+                                              : CHASHMAP_EMPTY;
+    }
+
+    for (i = 0U; i < cap; i++) {
+        if (ctrl[i] == CHASHMAP_DELETED) {
+            const cv_ui h = vnut_hm_mix((*map->hash)(slots + (i * t)));
+            const cv_ui target = vnut_hm_find_free(map, h);
+
+            if ((target / CHASHMAP_GROUP) == (i / CHASHMAP_GROUP)) {
+                ctrl[i] = vnut_hm_h2(h);
+            }
+            else if (ctrl[target] == CHASHMAP_EMPTY) {
+                memcpy(slots + (target * t), slots + (i * t), t);
+                ctrl[target] = vnut_hm_h2(h);
+                ctrl[i] = CHASHMAP_EMPTY;
+            }
+            else {
+                cv_uchar* const a = slots + (target * t);
+                cv_uchar* const b = slots + (i * t);
+                cv_ui j;
+                for (j = 0U; j < t; j++) {
+                    const cv_uchar c = a[j];
+                    a[j] = b[j];
+                    b[j] = c;
+                }
+                ctrl[target] = vnut_hm_h2(h);
+                i--;
+            }
+        }
+    }
+
+    map->left = vnut_hm_max_load(cap) - map->size;
+}
+
+static int vnut_hm_alloc(chashmap_t* map, cv_ui cap, cv_ui t) {
+    cvector_init(&map->ctrl, 1U, cap, CVECTOR_DATA);
+    if (map->ctrl.p != NULL) {
+        cvector_init(&map->slots, t, cap, CVECTOR_DATA);
+        if (map->slots.p != NULL) {
+            map->ctrl.n = map->slots.n = cap;
+            map->ctrl.f = map->ctrl.p + cap;
+            map->slots.f = map->slots.p + (cap * t);
+            vnut_hm_reset(map);
+        }
+        else {
+            cvector_destroy(&map->ctrl);
+        }
+    }
+    return (map->ctrl.p != NULL) ? 1 : 0;
+}
+
+static int vnut_hm_grow(chashmap_t* map) {
+    chashmap_t other = *map;
+    const cv_ui cap = map->ctrl.n;
+    const cv_ui t = map->slots.t;
+    int ok = 0;
+
+    if (((map->ctrl.d & 2U) == 0U) && (cap <= (map->slots.c / 2U))
+        && (vnut_hm_alloc(&other, cap * 2U, t) != 0))
+    {
+        cv_ui i;
+        for (i = 0U; i < cap; i++) {
+            if ((map->ctrl.p[i] & 0x80U) == 0U) {
+                const cv_uchar* const s = map->slots.p + (i * t);
+                const cv_ui h = vnut_hm_mix((*map->hash)(s));
+                const cv_ui target = vnut_hm_find_free(&other, h);
+                other.ctrl.p[target] = vnut_hm_h2(h);
+                memcpy(other.slots.p + (target * t), s, t);
+            }
+        }
+        other.size = map->size;
+        other.left = vnut_hm_max_load(cap * 2U) - map->size;
+        cvector_destroy(&map->ctrl);
+        cvector_destroy(&map->slots);
+        *map = other;
+        ok = 1;
+    }
+
+    return ok;
+}
+
+static cv_ui vnut_hm_capacity(cv_ui num_elems) {
+    cv_ui cap = CHASHMAP_GROUP;
+    while (vnut_hm_max_load(cap) < num_elems) {
+        cap *= 2U;
+    }
+    return cap;
+}
+
+/**
+ * @brief Initialize a hash table using dynamic memory
+ * @param[in] map A pointer to the table to initialize
+ * @param[in] key_size The size of the keys (ex.: sizeof(int)). Keys are
+ *            compared byte per byte, so padding bytes of structures used as
+ *            keys must be zeroed
+ * @param[in] value_size The size of the values. Pass zero to obtain a set
+ * @param[in] num_elems The number of entries the table must hold without
+ *            growing. Pass #CVECTOR_DEFAULT_LEN for the minimum capacity
+ * @param[in] hash The hash function of keys
+ * @note When this function fails, the error callback is called and
+ *       map->ctrl.p is set to NULL
+ */
+static void chashmap_init(chashmap_t* map,
+                          cv_ui key_size,
+                          cv_ui value_size,
+                          cv_ui num_elems,
+                          chashmap_hash_t hash)
+{
+    map->ks = key_size;
+    map->hash = hash;
+    (void)vnut_hm_alloc(map, vnut_hm_capacity(num_elems),
+                        key_size + value_size);
+}
+
+/**
+ * @brief Initialize a hash table with passed memory space. No dynamic memory
+ *        is required
+ * @param[in] map A pointer to the table to initialize
+ * @param[in] buffer A pointer to the memory the table will use. It must have
+ *            at least <a>CHASHMAP_BUFFER_SIZE(capacity, key_size,
+ *            value_size)</a> bytes
+ * @param[in] key_size The size of the keys, see chashmap_init()
+ * @param[in] value_size The size of the values. Pass zero to obtain a set
+ * @param[in] capacity The number of slots of the table. It must be a power of
+ *            two multiple of #CHASHMAP_GROUP. The table holds at most 7/8 of
+ *            this value entries
+ * @param[in] hash The hash function of keys
+ * @note The table never grows. Inserting in a full table calls the error
+ *       callback
+ */
+static void chashmap_init_ext(chashmap_t* map,
+                              void* buffer,
+                              cv_ui key_size,
+                              cv_ui value_size,
+                              cv_ui capacity,
+                              chashmap_hash_t hash)
+{
+    map->ks = key_size;
+    map->hash = hash;
+    cvector_init_ext(&map->ctrl, buffer, 1U, capacity, capacity, CVECTOR_DATA);
+    if (map->ctrl.p != NULL) {
+        cvector_init_ext(&map->slots, (cv_uchar*)buffer + capacity,
+                         key_size + value_size, capacity, capacity,
+                         CVECTOR_DATA);
+        if (map->slots.p != NULL) {
+            vnut_hm_reset(map);
+        }
+        else {
+            map->ctrl.p = NULL;
+        }
+    }
+}
+
+/**
+ * @brief Destroy a hash table, deallocating its entries
+ * @param[in] map A pointer to the table to destroy
+ */
+static void chashmap_destroy(chashmap_t* map) {
+    cvector_destroy(&map->ctrl);
+    cvector_destroy(&map->slots);
+}
+
+/**
+ * @brief Remove all entries from the table. No memory is freed
+ * @param[in] map A pointer to the table to clear
+ */
+static void chashmap_clear(chashmap_t* map) {
+    vnut_hm_reset(map);
+}
+
+/**
+ * @brief Return the number of entries of the table
+ * @param[in] map A constant pointer to the table
+ * @return The number of entries
+ */
+static cv_ui chashmap_size(const chashmap_t* map) {
+    return map->size;
+}
+
+/**
+ * @brief Return the number of slots of the table
+ * @param[in] map A constant pointer to the table
+ * @return The number of slots, see chashmap_next()
+ */
+static cv_ui chashmap_capacity(const chashmap_t* map) {
+    return map->ctrl.n;
+}
+
+/**
+ * @brief Find the value associated to given key
+ * @param[in] map A pointer to the table
+ * @param[in] key A pointer to the key to search
+ * @return A pointer to the value or NULL if \a key is not present. For sets,
+ *         the returned pointer must only be compared with NULL
+ */
+static void* chashmap_find(chashmap_t* map, const void* key) {
+    const cv_ui h = vnut_hm_mix((*map->hash)(key));
+    const cv_ui i = vnut_hm_find(map, key, h);
+    return (i < map->ctrl.n) ? (map->slots.p + (i * map->slots.t) + map->ks)
+                             : NULL;
+}
+
+/**
+ * @brief Insert an entry, or replace the value of an existing one
+ * @param[in] map A pointer to the table
+ * @param[in] key A pointer to the key of the entry
+ * @param[in] value A pointer to the value of the entry. Can be NULL to leave
+ *            the value uninitialized (or untouched if the key is present)
+ * @return A pointer to the stored value, or NULL if the table cannot grow.
+ *         In the latter case the error callback is called
+ * @note Any insertion may move all entries, invalidating returned pointers
+ */
+static void* chashmap_insert(chashmap_t* map,
+                             const void* key,
+                             const void* value)
+{
+    const cv_ui h = vnut_hm_mix((*map->hash)(key));
+    const cv_ui t = map->slots.t;
+    cv_ui i = vnut_hm_find(map, key, h);
+    cv_uchar* p = NULL;
+
+    if (i == map->ctrl.n) {
+        i = vnut_hm_find_free(map, h);
+
+        if ((map->left == 0U) && (map->ctrl.p[i] == CHASHMAP_EMPTY)) {
+            if ((map->size <= (vnut_hm_max_load(map->ctrl.n) / 2U))
+                || (vnut_hm_grow(map) == 0))
+            {
+                if (map->size < vnut_hm_max_load(map->ctrl.n)) {
+                    vnut_hm_drop_deleted(map);
+                }
+            }
+            i = (map->left > 0U) ? vnut_hm_find_free(map, h) : map->ctrl.n;
+        }
+
+        if (i < map->ctrl.n) {
+            if (map->ctrl.p[i] == CHASHMAP_EMPTY) {
+                map->left--;
+            }
+            map->ctrl.p[i] = vnut_hm_h2(h);
+            map->size++;
+            memcpy(map->slots.p + (i * t), key, map->ks);
+        }
+        else {
+            if (cvector_error_callback != NULL) {
+                (*cvector_error_callback)(map->size + 1U);
+            }
+        }
+    }
+
+    if (i < map->ctrl.n) {
+        p = map->slots.p + (i * t) + map->ks;
+        if ((value != NULL) && (t > map->ks)) {
+            memcpy(p, value, t - map->ks);
+        }
+    }
+
+    return p;
+}
+
+/**
+ * @brief Remove the entry with given key
+ * @param[in] map A pointer to the table
+ * @param[in] key A pointer to the key of the entry to remove
+ * @return Non-zero if the entry was present and has been removed, zero
+ *         otherwise
+ */
+static int chashmap_erase(chashmap_t* map, const void* key) {
+    const cv_ui h = vnut_hm_mix((*map->hash)(key));
+    const cv_ui i = vnut_hm_find(map, key, h);
+    const int found = (i < map->ctrl.n) ? 1 : 0;
+
+    if (found != 0) {
+        const cv_uchar* const group = map->ctrl.p
+                                      + ((i / CHASHMAP_GROUP) * CHASHMAP_GROUP);
+        if (vnut_hm_match(group, CHASHMAP_EMPTY) != 0U) {
+            map->ctrl.p[i] = CHASHMAP_EMPTY;
+            map->left++;
+        }
+        else {
+            map->ctrl.p[i] = CHASHMAP_DELETED;
+        }
+        map->size--;
+    }
+
+    return found;
+}
+
+/**
+ * @brief Return the index of the first used slot starting from \a idx
+ * @param[in] map A constant pointer to the table
+ * @param[in] idx The first slot to check
+ * @return The index of the slot, or chashmap_capacity() if there are no more
+ *         entries. The typical iteration is:
+ * @code{.c}
+ * for (i = chashmap_next(map, 0U); i < chashmap_capacity(map);
+ *      i = chashmap_next(map, i + 1U)) {
+ *     use(chashmap_key_at(map, i), chashmap_value_at(map, i));
+ * }
+ * @endcode
+ */
+static cv_ui chashmap_next(const chashmap_t* map, cv_ui idx) {
+    const cv_uchar* const ctrl = map->ctrl.p;
+    const cv_ui cap = map->ctrl.n;
+    while ((idx < cap) && ((ctrl[idx] & 0x80U) != 0U)) {
+        idx++;
+    }
+    return idx;
+}
+
+/**
+ * @brief Return a pointer to the key stored in slot \a idx
+ * @param[in] map A pointer to the table
+ * @param[in] idx The index of a used slot, see chashmap_next()
+ * @return A pointer to the key. Keys must never be modified through it
+ */
+static void* chashmap_key_at(chashmap_t* map, cv_ui idx) {
+    return map->slots.p + (idx * map->slots.t);
+}
+
+/**
+ * @brief Return a pointer to the value stored in slot \a idx
+ * @param[in] map A pointer to the table
+ * @param[in] idx The index of a used slot, see chashmap_next()
+ * @return A pointer to the value
+ */
+static void* chashmap_value_at(chashmap_t* map, cv_ui idx) {
+    return map->slots.p + (idx * map->slots.t) + map->ks;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,143 @@
+/**
+ * @file      cheap.h
+ * @version   1.0
+ * @brief     CHeap header-only priority queue library for C89 language
+ * @date      Sat Oct 17 01:22:48 2026
+ * @author    Michele Pes
+ * @copyright BSD-3-Clause
+ *
+ * This file offers d-ary heaps (priority queues) stored in a cvector.
+ * Heaps are generated by the #CHEAP_DEFINE macro for a given element type,
+ * comparison and arity, so that comparisons are expanded inline and elements
+ * are moved by plain assignments, with no indirect call. A 4-ary heap has
+ * half the levels of a binary heap and its children share a cache line, so
+ * it is usually faster on large heaps.
+ * CHeap follows the CVector philosophy: no checks are done and errors
+ * related to memory are reported through the cvector error callback, see
+ * cvector_set_callback()
+ */
+
+#ifndef CHEAP_H_
+#define CHEAP_H_
+
+#include "cvector.h"
+
+/**
+ * @def CHEAP_DEFINE
+ * This macro defines the functions of a heap whose elements have type \a T.
+ * The heap is a min-heap according to \a LESS: the top is the element
+ * for which <a>LESS(top, x)</a> is true for every other x, or one of them on
+ * ties. The generated functions (prefixed by \a name) are:
+ * - <b>void name_push(cvector_t* pv, const T* elem)</b>: add an element
+ * - <b>T* name_top(cvector_t* pv)</b>: return the top element (the heap must
+ *   not be empty)
+ * - <b>void name_pop(cvector_t* pv)</b>: remove the top element (the heap must
+ *   not be empty)
+ * - <b>void name_heapify(cvector_t* pv)</b>: turn any vector into a heap in
+ *   linear time
+ * - <b>void name_decrease_key(cvector_t* pv, cv_ui idx, const T* elem)</b>:
+ *   replace the element at index \a idx with a smaller or equal one
+ * - <b>void name_update(cvector_t* pv, cv_ui idx)</b>: restore the heap after
+ *   the element at index \a idx has been changed in any way
+ *
+ * @param name The prefix of the generated functions
+ * @param T The type of the elements. The vector must have been initialized
+ *          with <a>sizeof(T)</a> as type size and #CVECTOR_DATA
+ * @param LESS A function-like macro or a function taking two values of type
+ *             \a T and returning non-zero if the first one has to be closer to
+ *             the top than the second one
+ * @param ARITY The number of children of each node, typically 2 or 4
+ * @code{.c}
+ * #define INT_LESS(a, b) ((a) < (b))
+ * CHEAP_DEFINE(iheap, int, INT_LESS, 4)
+ * ...
+ * iheap_push(pv, &x);
+ * x = *iheap_top(pv);
+ * iheap_pop(pv);
+ * @endcode
+ */
+#define CHEAP_DEFINE(name, T, LESS, ARITY)                                    \
+static void name##_sift_up(cvector_t* pv, cv_ui i) {                         \
+    T* const a = (T*)pv->p;                                                   \
+    const T x = a[i];                                                         \
+    while (i > 0U) {                                                          \
+        const cv_ui parent = (i - 1U) / (ARITY);                              \
+        if (!(LESS(x, a[parent]))) {                                          \
+            break;                                                            \
+        }                                                                     \
+        a[i] = a[parent];                                                     \
+        i = parent;                                                           \
+    }                                                                         \
+    a[i] = x;                                                                 \
+}                                                                             \
+                                                                              \
+static void name##_sift_down(cvector_t* pv, cv_ui i) {                       \
+    T* const a = (T*)pv->p;                                                   \
+    const cv_ui n = pv->n;                                                    \
+    const T x = a[i];                                                         \
+    for (;;) {                                                                \
+        const cv_ui first = (i * (ARITY)) + 1U;                               \
+        cv_ui best, c, last;                                                  \
+        if (first >= n) {                                                     \
+            break;                                                            \
+        }                                                                     \
+        last = ((n - first) > (ARITY)) ? (first + (ARITY)) : n;               \
+        best = first;                                                         \
+        for (c = first + 1U; c < last; c++) {                                 \
+            if (LESS(a[c], a[best])) {                                        \
+                best = c;                                                     \
+            }                                                                 \
+        }                                                                     \
+        if (!(LESS(a[best], x))) {                                            \
+            break;                                                            \
+        }                                                                     \
+        a[i] = a[best];                                                       \
+        i = best;                                                             \
+    }                                                                         \
+    a[i] = x;                                                                 \
+}                                                                             \
+                                                                              \
+static void name##_push(cvector_t* pv, const T* elem) {                      \
+    const cv_ui n = pv->n;                                                    \
+    cvector_push_back(pv, elem);                                              \
+    if (pv->n > n) {                                                          \
+        name##_sift_up(pv, n);                                                \
+    }                                                                         \
+}                                                                             \
+                                                                              \
+static T* name##_top(cvector_t* pv) {                                        \
+    return (T*)pv->p;                                                         \
+}                                                                             \
+                                                                              \
+static void name##_pop(cvector_t* pv) {                                      \
+    T* const a = (T*)pv->p;                                                   \
+    const cv_ui n = pv->n - 1U;                                               \
+    pv->n = n;                                                                \
+    pv->f -= sizeof(T);                                                       \
+    if (n > 0U) {                                                             \
+        a[0] = a[n];                                                          \
+        name##_sift_down(pv, 0U);                                             \
+    }                                                                         \
+}                                                                             \
+                                                                              \
+static void name##_heapify(cvector_t* pv) {                                  \
+    cv_ui i = pv->n;                                                          \
+    if (i > 1U) {                                                             \
+        i = ((i - 2U) / (ARITY)) + 1U;                                        \
+        while (i-- > 0U) {                                                    \
+            name##_sift_down(pv, i);                                          \
+        }                                                                     \
+    }                                                                         \
+}                                                                             \
+                                                                              \
+static void name##_decrease_key(cvector_t* pv, cv_ui idx, const T* elem) {   \
+    ((T*)pv->p)[idx] = *elem;                                                 \
+    name##_sift_up(pv, idx);                                                  \
+}                                                                             \
+                                                                              \
+static void name##_update(cvector_t* pv, cv_ui idx) {                        \
+    name##_sift_up(pv, idx);                                                  \
+    name##_sift_down(pv, idx);                                                \
+}
+
+#endif
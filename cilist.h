@@ -0,0 +1,255 @@
+/**
+ * @file      cilist.h
+ * @version   1.0
+ * @brief     CIList header-only intrusive list library for C89 language
+ * @date      Sat Oct 17 01:39:09 2026
+ * @author    Michele Pes
+ * @copyright BSD-3-Clause
+ *
+ * This file offers an intrusive double-linked list: user structures embed a
+ * clist_node_t and the list links them in place, so that no memory is
+ * allocated nor copied by the list. The structure of a node is recovered
+ * from its link with #CILIST_CONTAINER_OF. Knowing a node, inserting next to
+ * it and removing it are O(1).
+ * Like CList, all pointers are NULL-checked: passing a NULL list or node
+ * does nothing. The list does not own the nodes, so removed nodes are never
+ * freed and a node must not be linked in two lists with the same member
+ */
+
+#ifndef CILIST_H_
+#define CILIST_H_
+
+#include <stddef.h>
+#include "clist.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def CILIST_CONTAINER_OF
+ * Return a pointer to the structure of type \a type whose member \a member is
+ * the link pointed by \a node
+ * @code{.c}
+ * typedef struct {
+ *     int fd;
+ *     clist_node_t link;
+ * } conn_t;
+ * ...
+ * conn_t* c = CILIST_CONTAINER_OF(cilist_head(&list), conn_t, link);
+ * @endcode
+ */
+#define CILIST_CONTAINER_OF(node, type, member) \
+    ((type*)(void*)((char*)(node) - offsetof(type, member)))
+
+typedef struct {
+    clist_node_t* head;
+    clist_node_t* tail;
+    size_t size;
+} cilist_t;
+
+/**
+ * @brief Initialize an empty intrusive list
+ * @param[in] list The list to initialize
+ */
+static void cilist_init(cilist_t* list) {
+    if (list != NULL) {
+        list->head = list->tail = NULL;
+        list->size = 0U;
+    }
+}
+
+/**
+ * @brief Return the number of nodes of the list
+ * @param[in] list The list to operate with
+ * @return The size of the list or zero if \a list is NULL
+ */
+static size_t cilist_size(const cilist_t* list) {
+    return (list != NULL) ? list->size : 0U;
+}
+
+/**
+ * @brief Tell if list is empty
+ * @param[in] list The list to operate with
+ * @retval 1 if \a list is NULL or it is empty
+ * @retval 0 if \a list is not NULL and has some nodes
+ */
+static int cilist_empty(const cilist_t* list) {
+    return ((list != NULL) && (list->size > 0U)) ? 0 : 1;
+}
+
+/**
+ * @brief Return the first node of the list
+ * @param[in] list The list to operate with
+ * @return The first node, or NULL if the list is empty or \a list is NULL
+ */
+static clist_node_t* cilist_head(cilist_t* list) {
+    return (list != NULL) ? list->head : NULL;
+}
+
+/**
+ * @brief Return the last node of the list
+ * @param[in] list The list to operate with
+ * @return The last node, or NULL if the list is empty or \a list is NULL
+ */
+static clist_node_t* cilist_tail(cilist_t* list) {
+    return (list != NULL) ? list->tail : NULL;
+}
+
+/**
+ * @brief Insert a node after another one
+ * @param[in] list The list to operate with
+ * @param[in] pos The node after which \a node is inserted. It must belong to
+ *            \a list. If it is NULL, \a node becomes the head
+ * @param[in] node The node to insert. It must not be linked in any list
+ */
+static void cilist_insert_after(cilist_t* list,
+                                clist_node_t* pos,
+                                clist_node_t* node)
+{
+    if ((list != NULL) && (node != NULL)) {
+        clist_node_t* const next = (pos != NULL) ? pos->next : list->head;
+
+        node->prev = pos;
+        node->next = next;
+
+        if (pos != NULL) {
+            pos->next = node;
+        }
+        else {
+            list->head = node;
+        }
+
+        if (next != NULL) {
+            next->prev = node;
+        }
+        else {
+            list->tail = node;
+        }
+
+        list->size++;
+    }
+}
+
+/**
+ * @brief Insert a node before another one
+ * @param[in] list The list to operate with
+ * @param[in] pos The node before which \a node is inserted. It must belong to
+ *            \a list. If it is NULL, \a node becomes the tail
+ * @param[in] node The node to insert. It must not be linked in any list
+ */
+static void cilist_insert_before(cilist_t* list,
+                                 clist_node_t* pos,
+                                 clist_node_t* node)
+{
+    if (list != NULL) {
+        cilist_insert_after(list, (pos != NULL) ? pos->prev : list->tail,
+                            node);
+    }
+}
+
+/**
+ * @brief Add a node at the beginning of the list
+ * @param[in] list The list to operate with
+ * @param[in] node The node to add. It must not be linked in any list
+ */
+static void cilist_push_front(cilist_t* list, clist_node_t* node) {
+    cilist_insert_after(list, NULL, node);
+}
+
+/**
+ * @brief Add a node at the end of the list
+ * @param[in] list The list to operate with
+ * @param[in] node The node to add. It must not be linked in any list
+ */
+static void cilist_push_back(cilist_t* list, clist_node_t* node) {
+    cilist_insert_before(list, NULL, node);
+}
+
+/**
+ * @brief Unlink a node from the list
+ * @param[in] list The list to operate with
+ * @param[in] node The node to remove. It must belong to \a list
+ * @note The node is not freed, and its links are set to NULL
+ */
+static void cilist_remove(cilist_t* list, clist_node_t* node) {
+    if ((list != NULL) && (node != NULL)) {
+        if (node->prev != NULL) {
+            node->prev->next = node->next;
+        }
+        else {
+            list->head = node->next;
+        }
+
+        if (node->next != NULL) {
+            node->next->prev = node->prev;
+        }
+        else {
+            list->tail = node->prev;
+        }
+
+        node->next = node->prev = NULL;
+        list->size--;
+    }
+}
+
+/**
+ * @brief Unlink the first node of the list
+ * @param[in] list The list to operate with
+ * @return The removed node, or NULL if the list is empty or \a list is NULL
+ */
+static clist_node_t* cilist_pop_front(cilist_t* list) {
+    clist_node_t* const node = cilist_head(list);
+    cilist_remove(list, node);
+    return node;
+}
+
+/**
+ * @brief Unlink the last node of the list
+ * @param[in] list The list to operate with
+ * @return The removed node, or NULL if the list is empty or \a list is NULL
+ */
+static clist_node_t* cilist_pop_back(cilist_t* list) {
+    clist_node_t* const node = cilist_tail(list);
+    cilist_remove(list, node);
+    return node;
+}
+
+/**
+ * @brief Unlink all the nodes of the list
+ * @param[in] list The list to clear
+ * @note Nodes are neither freed nor modified, so they must be considered
+ *       unlinked. See #CILIST_CONTAINER_OF to free their structures while
+ *       traversing the list before this call
+ */
+static void cilist_clear(cilist_t* list) {
+    cilist_init(list);
+}
+
+/**
+ * @brief Move all the nodes of a list at the end of another one, in O(1)
+ * @param[in] dest The list receiving the nodes
+ * @param[in] source The list to empty. It must be different from \a dest
+ */
+static void cilist_append(cilist_t* dest, cilist_t* source) {
+    if ((dest != NULL) && (source != NULL) && (dest != source)
+        && (source->head != NULL))
+    {
+        source->head->prev = dest->tail;
+        if (dest->tail != NULL) {
+            dest->tail->next = source->head;
+        }
+        else {
+            dest->head = source->head;
+        }
+        dest->tail = source->tail;
+        dest->size += source->size;
+        cilist_init(source);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
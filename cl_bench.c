@@ -4,6 +4,7 @@ clang -Ofast -oul.exe cl_bench.c
 
 gcc -Ofast -ocl -DCLIST cl_bench.c
 gcc -Ofast -oul cl_bench.c
+gcc -Ofast -oclc -DCLIST -DCLIST_THREAD_CACHE cl_bench.c
 
 cl /O2 /Fecl -DCLIST cl_bench.c
 cl /O2 /Feul cl_bench.c
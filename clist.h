@@ -3,7 +3,7 @@
  * @version   1.0
  * @brief     CList header-only list library for C89 language
  * @date      Wed Oct 14 18:17:25 2020
- * @author    Michele Pess
+ * @author    Michele Pes
  * @copyright BSD-3-Clause
  *
  * This file offers a traditional C++-like double-linked list to C.
@@ -11,7 +11,9 @@
  * functions of a list plus the possibility to free pointers on deletion.
  * The CList APIs are secure, all pointers are NULL-checked and all indexes
  * are checked against out-of-bound errors. If something goes wrong an error is
- * returned or nothing is done
+ * returned or nothing is done. The only exceptions are the clist_u_*
+ * functions (see the "Unchecked functions" group) and the #CLIST_FOREACH
+ * family of macros, which check nothing: the caller guarantees validity
  */
 
 #ifndef CLIST_H_
@@ -20,6 +22,31 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef DOXYGEN_ONLY
+/**
+ * @def CLIST_ARENA
+ * If this macro is defined \b before including clist.h, carena.h is included
+ * and lists can take their nodes from an arena, see clist_init_arena().
+ * Otherwise clist.h needs no other file
+ */
+#define CLIST_ARENA
+
+/**
+ * @def CLIST_DEFRAG
+ * If this macro is defined \b before including clist.h, clist_defragment()
+ * and clist_defragment_step() are available, and clist_append_array()
+ * allocates its nodes in one block. Every node allocated by malloc then ends
+ * with a pointer to its block (NULL for a node allocated alone), so that a
+ * block is freed when its last node is released, by whatever list holds it
+ * at that time. Otherwise nodes keep their minimal size
+ */
+#define CLIST_DEFRAG
+#endif
+
+#ifdef CLIST_ARENA
+#include "carena.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -39,6 +66,13 @@ extern "C" {
  * @}
  */
 
+/**
+ * @def CLIST_RETAIN_ALL
+ * Value to pass to clist_set_retention() to not limit the number of nodes or
+ * bytes kept for reuse. This is the default
+ */
+#define CLIST_RETAIN_ALL ((size_t)-1)
+
 /**
  * @def CLIST_NODE_PTR
  * Helper macro that cast the pointer to value stored on node \a n to type
@@ -57,12 +91,118 @@ extern "C" {
  */
 #define CLIST_PTR(l, i, t) ((t*)clist_get((l), (i)))
 
+/**
+ * @def CLIST_FOREACH
+ * This macro expands to a \a for statement visiting all the nodes of the
+ * list \a l, from the head to the tail. Being a plain loop, no function is
+ * called per node
+ * @param[in] l A pointer to the list to work with. Must not be NULL
+ * @param[in] node A variable of type <a>clist_node_t*</a>, declared by the
+ *                 caller, that points to the current node
+ * @code{.c}
+ * clist_node_t* node;
+ * long sum = 0;
+ * CLIST_FOREACH(&list, node) {
+ *     sum += *CLIST_NODE_PTR(node, int);
+ * }
+ * @endcode
+ * @warning The current node must not be erased inside the loop, see
+ *          #CLIST_FOREACH_SAFE
+ */
+#define CLIST_FOREACH(l, node) \
+    for ((node) = (l)->head; (node) != NULL; (node) = (node)->next)
+
+/**
+ * @def CLIST_FOREACH_SAFE
+ * Like #CLIST_FOREACH, but the next node is read before executing the body,
+ * so the current node can be erased (see clist_erase_node())
+ * @param[in] l A pointer to the list to work with. Must not be NULL
+ * @param[in] node A variable of type <a>clist_node_t*</a> pointing to the
+ *                 current node
+ * @param[in] tmp A variable of type <a>clist_node_t*</a> used to hold the
+ *                next node
+ */
+#define CLIST_FOREACH_SAFE(l, node, tmp) \
+    for ((node) = (l)->head; \
+         ((node) != NULL) && (((tmp) = (node)->next), 1); \
+         (node) = (tmp))
+
+/**
+ * @def CLIST_FOREACH_REVERSE
+ * Like #CLIST_FOREACH, but visiting the nodes from the tail to the head
+ * @param[in] l A pointer to the list to work with. Must not be NULL
+ * @param[in] node A variable of type <a>clist_node_t*</a> pointing to the
+ *                 current node
+ */
+#define CLIST_FOREACH_REVERSE(l, node) \
+    for ((node) = (l)->tail; (node) != NULL; (node) = (node)->prev)
+
+/**
+ * @name Branch and inlining hints
+ * Used by the unchecked clist_u_* functions. They expand to plain C on
+ * compilers not offering the corresponding builtins
+ * @{
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define CLIST_LIKELY(x)   __builtin_expect(!!(x), 1)
+#define CLIST_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#define CLIST_INLINE      static __inline__ __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define CLIST_LIKELY(x)   (x)
+#define CLIST_UNLIKELY(x) (x)
+#define CLIST_INLINE      static __forceinline
+#else
+#define CLIST_LIKELY(x)   (x)
+#define CLIST_UNLIKELY(x) (x)
+#define CLIST_INLINE      static
+#endif
+/**
+ * @}
+ */
+
+/**
+ * @def CLIST_PREFETCH
+ * This macro hints the processor to load in cache the node pointed by \a p.
+ * It expands to nothing on compilers not offering a prefetch builtin
+ * @param[in] p The address to prefetch. It is never dereferenced, so it can
+ *              be NULL
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define CLIST_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define CLIST_PREFETCH(p) ((void)0)
+#endif
+
+/**
+ * @def CLIST_PREFETCH_DISTANCE
+ * How many nodes ahead of the current one the traversals calling a function
+ * per node (clist_foreach(), clist_filter(), ...) prefetch. While the
+ * function runs, the load of a node further in the list is in flight. It
+ * pays when the work per node is comparable to a cache miss, see
+ * pf_bench.c: a bare walk stays bound by the latency of the chain of
+ * pointers. Zero disables prefetching
+ */
+#ifndef CLIST_PREFETCH_DISTANCE
+#define CLIST_PREFETCH_DISTANCE 4U
+#endif
+
 
 typedef struct vnut_node_t {
     struct vnut_node_t* next;
     struct vnut_node_t* prev;
 } clist_node_t;
 
+typedef struct vnut_cl_slab_t {
+    unsigned char* end;
+    size_t live;
+} vnut_cl_slab_t;
+
+#define VNUT_CL_ROUND(x) \
+    ((((x) + sizeof(clist_node_t)) - 1U) \
+     & ~(size_t)(sizeof(clist_node_t) - 1U))
+
+#define VNUT_CL_SLAB_HEADER VNUT_CL_ROUND(sizeof(vnut_cl_slab_t))
+
 typedef struct {
     clist_node_t* head;
     clist_node_t* tail;
@@ -73,20 +213,375 @@ typedef struct {
     size_t ruly;
     size_t zskb;
     unsigned int flags;
+    struct vnut_arena_t* arena;
+    size_t keep;
+    size_t peak;
+    unsigned int decay;
+    vnut_cl_slab_t* dslab;
+    unsigned char* dpos;
+    size_t didx;
 } clist_t;
 
+#ifdef DOXYGEN_ONLY
+/**
+ * @def CLIST_THREAD_CACHE
+ * If this macro is defined \b before including clist.h, nodes are not
+ * allocated one by one with malloc, but taken from a cache owned by the
+ * calling thread and shared by all its lists. The cache has a free list for
+ * each node size class (a multiple of 8 bytes up to #CLIST_CACHE_MAX_NODE),
+ * refilled by carving slabs of #CLIST_CACHE_SLAB bytes. Every node is
+ * preceded by a pointer to its owner cache: a node released by another
+ * thread is pushed on a lock-free queue of the owner, which takes the queue
+ * back when its own free list of that class is empty. So, in steady state,
+ * adding and removing nodes does not call malloc nor free.
+ * It requires GCC/Clang thread-local storage and atomic builtins
+ * @note Payloads are aligned to 8 bytes only
+ * @note Slabs are never returned to the system, and the cache of a thread
+ *       is not freed when the thread exits: use it with long-lived threads
+ */
+#define CLIST_THREAD_CACHE
+#endif
+
+#ifdef CLIST_THREAD_CACHE
+
+#if !defined(__GNUC__) && !defined(__clang__)
+#error "CLIST_THREAD_CACHE requires GCC or Clang"
+#endif
+
+/**
+ * @def CLIST_CACHE_MAX_NODE
+ * The maximum size in \b bytes of a cached node, including its bookkeeping.
+ * Bigger nodes are allocated by malloc. It must be a multiple of 8
+ */
+#ifndef CLIST_CACHE_MAX_NODE
+#define CLIST_CACHE_MAX_NODE 256U
+#endif
+
+/**
+ * @def CLIST_CACHE_SLAB
+ * The size in \b bytes of the slabs carved into nodes. It must be at least
+ * #CLIST_CACHE_MAX_NODE
+ */
+#ifndef CLIST_CACHE_SLAB
+#define CLIST_CACHE_SLAB 16384U
+#endif
+
+#define VNUT_CL_GRAIN 8U
+#define VNUT_CL_CLASSES (CLIST_CACHE_MAX_NODE / VNUT_CL_GRAIN)
+
+typedef struct vnut_cl_cache_t {
+    clist_node_t* free[VNUT_CL_CLASSES];
+    clist_node_t* remote[VNUT_CL_CLASSES];
+} vnut_cl_cache_t;
+
+static __thread vnut_cl_cache_t* vnut_cl_tls = NULL;
+
+static vnut_cl_cache_t** vnut_cl_owner(clist_node_t* node) {
+    return (vnut_cl_cache_t**)node - 1;
+}
+
+static void vnut_cl_refill(vnut_cl_cache_t* c, size_t cls) {
+    const size_t stride = (cls + 1U) * VNUT_CL_GRAIN;
+    unsigned char* const slab = (unsigned char*)malloc(CLIST_CACHE_SLAB);
+
+    if (slab != NULL) {
+        size_t i = (CLIST_CACHE_SLAB / stride);
+        while (i-- > 0U) {
+            vnut_cl_cache_t** const h = (vnut_cl_cache_t**)(slab
+                                                            + (i * stride));
+            clist_node_t* const node = (clist_node_t*)(h + 1);
+            *h = c;
+            node->next = c->free[cls];
+            c->free[cls] = node;
+        }
+    }
+}
+
+static clist_node_t* vnut_cl_cache_alloc(size_t bytes) {
+    const size_t total = bytes + sizeof(vnut_cl_cache_t*);
+    clist_node_t* node = NULL;
+
+    if (vnut_cl_tls == NULL) {
+        vnut_cl_tls = (vnut_cl_cache_t*)calloc(1U, sizeof(vnut_cl_cache_t));
+    }
+
+    if ((vnut_cl_tls != NULL) && (total <= CLIST_CACHE_MAX_NODE)) {
+        vnut_cl_cache_t* const c = vnut_cl_tls;
+        const size_t cls = (total - 1U) / VNUT_CL_GRAIN;
+
+        if (c->free[cls] == NULL) {
+            c->free[cls] = __atomic_exchange_n(&c->remote[cls], NULL,
+                                               __ATOMIC_ACQUIRE);
+            if (c->free[cls] == NULL) {
+                vnut_cl_refill(c, cls);
+            }
+        }
+
+        node = c->free[cls];
+        if (node != NULL) {
+            c->free[cls] = node->next;
+        }
+    }
+    else {
+        vnut_cl_cache_t** const h = (vnut_cl_cache_t**)malloc(total);
+        if (h != NULL) {
+            *h = NULL;
+            node = (clist_node_t*)(h + 1);
+        }
+    }
+
+    return node;
+}
+
+static void vnut_cl_cache_free(clist_node_t* node, size_t bytes) {
+    vnut_cl_cache_t* const owner = *vnut_cl_owner(node);
+    const size_t cls = (bytes + sizeof(vnut_cl_cache_t*) - 1U)
+                       / VNUT_CL_GRAIN;
+
+    if (owner == NULL) {
+        free(vnut_cl_owner(node));
+    }
+    else if (owner == vnut_cl_tls) {
+        node->next = owner->free[cls];
+        owner->free[cls] = node;
+    }
+    else {
+        clist_node_t* head = __atomic_load_n(&owner->remote[cls],
+                                             __ATOMIC_RELAXED);
+        do {
+            node->next = head;
+        } while (!__atomic_compare_exchange_n(&owner->remote[cls], &head,
+                                              node, 1, __ATOMIC_RELEASE,
+                                              __ATOMIC_RELAXED));
+    }
+}
+
+#endif
+
+#ifdef CLIST_DEFRAG
+
+/* nodes allocated by malloc end with a pointer to the block holding them
+   (NULL for a node allocated alone), so that a node is released the same
+   way by any list it has been spliced to */
+#define VNUT_CL_TAG(t) \
+    (((sizeof(clist_node_t) + (t)) + (sizeof(void*) - 1U)) \
+     & ~(size_t)(sizeof(void*) - 1U))
+
+/* the nodes of a block may be released by lists of different threads */
+#if defined(__GNUC__) || defined(__clang__)
+#define VNUT_CL_UNREF(s, n) \
+    __atomic_sub_fetch(&(s)->live, (n), __ATOMIC_ACQ_REL)
+#else
+#define VNUT_CL_UNREF(s, n) ((s)->live -= (n))
+#endif
+
+#endif
+
+static size_t vnut_cl_bytes(const clist_t* list) {
+    size_t bytes = sizeof(clist_node_t) + list->type_size;
+
+#ifdef CLIST_DEFRAG
+    if ((list->arena == NULL) && ((list->flags & 4U) == 0U)) {
+        bytes = VNUT_CL_TAG(list->type_size) + sizeof(vnut_cl_slab_t*);
+    }
+#endif
+
+    return bytes;
+}
+
+#ifdef CLIST_DEFRAG
+
+static vnut_cl_slab_t** vnut_cl_tag(const clist_t* list, clist_node_t* node)
+{
+    return (vnut_cl_slab_t**)(void*)((unsigned char*)node
+                                     + VNUT_CL_TAG(list->type_size));
+}
+
+static void vnut_cl_unref(vnut_cl_slab_t* s, size_t count) {
+    if (VNUT_CL_UNREF(s, count) == 0U) {
+        free(s);
+    }
+}
+
+/* a block of count nodes, all counted as live until released */
+static vnut_cl_slab_t* vnut_cl_new_slab(const clist_t* list, size_t count) {
+    const size_t stride = VNUT_CL_ROUND(vnut_cl_bytes(list));
+    const size_t bytes = count * stride;
+    vnut_cl_slab_t* s = NULL;
+
+    if ((stride > list->type_size) && ((bytes / stride) == count)
+        && (bytes <= ((size_t)-1 - VNUT_CL_SLAB_HEADER)))
+    {
+        s = (vnut_cl_slab_t*)malloc(VNUT_CL_SLAB_HEADER + bytes);
+        if (s != NULL) {
+            s->end = (unsigned char*)s + VNUT_CL_SLAB_HEADER + bytes;
+            s->live = count;
+        }
+    }
+
+    return s;
+}
+
+static void vnut_cl_defrag_end(clist_t* list) {
+    const size_t stride = VNUT_CL_ROUND(vnut_cl_bytes(list));
+
+    /* the slots the pass did not fill will never be released */
+    vnut_cl_unref(list->dslab,
+                  (size_t)(list->dslab->end - list->dpos) / stride);
+    list->dslab = NULL;
+    list->dpos = NULL;
+}
+
+#endif
+
+static void vnut_cl_release(clist_t* list, clist_node_t* node) {
+#ifdef CLIST_DEFRAG
+    vnut_cl_slab_t* const s = *vnut_cl_tag(list, node);
+
+    if (s != NULL) {
+        vnut_cl_unref(s, 1U);
+    }
+    else
+#endif
+    {
+#ifdef CLIST_THREAD_CACHE
+        vnut_cl_cache_free(node, vnut_cl_bytes(list));
+#else
+        (void)list;
+        free(node);
+#endif
+    }
+}
+
+/* a node allocated alone, not taken from the free nodes of the list */
+static clist_node_t* vnut_cl_heap_node(const clist_t* list) {
+#ifdef CLIST_THREAD_CACHE
+    clist_node_t* const node = vnut_cl_cache_alloc(vnut_cl_bytes(list));
+#else
+    clist_node_t* const node = (clist_node_t*)malloc(vnut_cl_bytes(list));
+#endif
+
+#ifdef CLIST_DEFRAG
+    if (node != NULL) {
+        *vnut_cl_tag(list, node) = NULL;
+    }
+#endif
+
+    return node;
+}
+
+static clist_node_t* vnut_cl_alloc_node(clist_t* list) {
+    clist_node_t* node;
+
+    if (list->zskb > 0U) {
+        node = list->pkb;
+        list->pkb = node->next;
+        list->zskb--;
+    }
+    else if ((list->flags & 4U) != 0U) {
+        node = NULL;
+    }
+#ifdef CLIST_ARENA
+    else if (list->arena != NULL) {
+        node = (clist_node_t*)carena_alloc(list->arena, vnut_cl_bytes(list));
+    }
+#endif
+    else {
+        node = vnut_cl_heap_node(list);
+    }
+
+    return node;
+}
+
+static void vnut_cl_free_node(clist_t* list, clist_node_t* node) {
+#ifdef CLIST_THREAD_CACHE
+#ifdef CLIST_DEFRAG
+    if ((list->arena == NULL) && ((list->flags & 4U) == 0U)
+        && (*vnut_cl_tag(list, node) == NULL))
+#else
+    if ((list->arena == NULL) && ((list->flags & 4U) == 0U))
+#endif
+    {
+        vnut_cl_cache_free(node, vnut_cl_bytes(list));
+    }
+    else
+#endif
+    {
+        node->next = list->pkb;
+        list->pkb = node;
+        list->zskb++;
+    }
+}
+
+static void vnut_cl_trim(clist_t* list) {
+    size_t limit = list->keep;
+
+    if (list->decay > 0U) {
+        list->peak -= list->peak >> list->decay;
+        if (list->peak < list->size) {
+            list->peak = list->size;
+        }
+        if ((list->peak - list->size) < limit) {
+            limit = list->peak - list->size;
+        }
+    }
+
+    if ((list->arena == NULL) && ((list->flags & 4U) == 0U)) {
+        while (list->zskb > limit) {
+            clist_node_t* const node = list->pkb;
+            list->pkb = node->next;
+            list->zskb--;
+            vnut_cl_release(list, node);
+        }
+    }
+}
+
 /**
  * @typedef clist_foreach_cb_t
  * Prototype for callback function to pass to clist_foreach()
  */
 typedef void (*clist_foreach_cb_t)(void*);
 
+/**
+ * @typedef clist_foreach_ctx_cb_t
+ * Prototype for callback function to pass to clist_foreach_ctx(). It
+ * receives a pointer to the value and the context given by the caller
+ */
+typedef void (*clist_foreach_ctx_cb_t)(void*, void*);
+
 /**
  * @typedef clist_filter_cb_t
  * Prototype for callback function to pass to clist_filter()
  */
 typedef int (*clist_filter_cb_t)(void*);
 
+/**
+ * @typedef clist_filter_ctx_cb_t
+ * Prototype for callback function to pass to clist_filter_ctx(). It
+ * receives a pointer to the value and the context given by the caller
+ */
+typedef int (*clist_filter_ctx_cb_t)(void*, void*);
+
+/**
+ * @typedef clist_cmp_cb_t
+ * Prototype for comparison function to pass to clist_sort() and
+ * clist_merge(). It receives pointers to two values and must return a
+ * negative value, zero or a positive value if the first one is respectively
+ * less than, equal to or greater than the second one (like \a qsort)
+ */
+typedef int (*clist_cmp_cb_t)(const void*, const void*);
+
+/**
+ * @brief A position in a list, owned by the caller: a node and its index.
+ *        A cursor whose node is NULL holds no position
+ * @note A cursor is not updated by functions modifying the list without
+ *       it: after such a change it must be reset by clist_cursor_reset()
+ */
+typedef struct {
+    clist_node_t* node;
+    size_t idx;
+} clist_cursor_t;
+
 
 /**
  * @brief Initialize a list
@@ -114,6 +609,92 @@ static int clist_init(clist_t* list, size_t type_size, unsigned int dynamic)
         list->type_size = type_size;
         list->size = list->zskb = 0U;
         list->flags = dynamic & 1U;
+        list->arena = NULL;
+        list->keep = CLIST_RETAIN_ALL;
+        list->peak = 0U;
+        list->decay = 0U;
+        list->dslab = NULL;
+        list->dpos = NULL;
+        list->didx = 0U;
+        ok = EXIT_SUCCESS;
+    }
+    return ok;
+}
+
+#ifdef CLIST_ARENA
+/**
+ * @brief Initialize a list whose nodes are allocated from an arena, see
+ *        carena.h. Available if #CLIST_ARENA is defined
+ * @param[in] list The list to initialize
+ * @param[in] arena The arena providing the nodes. It must outlive the list
+ * @param[in] type_size See explanation on clist_init()
+ * @param[in] dynamic See explanation on clist_init()
+ * @retval EXIT_SUCCESS If list is correctly initialized
+ * @retval EXIT_FAILURE If \a list or \a arena is NULL or \a dynamic has an
+ *         invalid value
+ * @note Nodes are never freed: clist_destroy() only frees the elements if
+ *       #CLIST_PAYLOAD_FREE was passed, and the memory is reclaimed by
+ *       carena_reset(). Nodes can be spliced only between lists using the
+ *       same arena
+ */
+static int clist_init_arena(clist_t* list,
+                            carena_t* arena,
+                            size_t type_size,
+                            unsigned int dynamic)
+{
+    int ok = EXIT_FAILURE;
+    if ((arena != NULL)
+        && (clist_init(list, type_size, dynamic) == EXIT_SUCCESS))
+    {
+        list->arena = arena;
+        ok = EXIT_SUCCESS;
+    }
+    return ok;
+}
+#endif
+
+/**
+ * @brief Initialize a list whose nodes are carved from a user buffer, so
+ *        that the list never calls malloc nor free
+ * @param[in] list The list to initialize
+ * @param[in] buffer The memory of the nodes. It must outlive the list and is
+ *            never freed by the list
+ * @param[in] size The size in \b bytes of \a buffer
+ * @param[in] type_size The size of type of elements of the list
+ * @retval EXIT_SUCCESS If list is correctly initialized
+ * @retval EXIT_FAILURE If \a list or \a buffer is NULL, \a type_size is zero
+ *         or \a buffer cannot hold a single node
+ * @note The buffer is split at once in a fixed pool of nodes, all kept as
+ *       free nodes: adding elements fails with EXIT_FAILURE when the pool is
+ *       exhausted, and removing elements gives their nodes back to the pool.
+ *       Elements are simply discarded (#CLIST_PAYLOAD_IGNORE)
+ * @note Nodes can be spliced only between lists initialized by this
+ *       function. clist_defragment() is not available
+ */
+static int clist_init_ext(clist_t* list,
+                          void* buffer,
+                          size_t size,
+                          size_t type_size)
+{
+    const size_t stride = VNUT_CL_ROUND(sizeof(clist_node_t) + type_size);
+    const size_t skew = (size_t)buffer & (sizeof(clist_node_t) - 1U);
+    const size_t pad = (skew > 0U) ? (sizeof(clist_node_t) - skew) : 0U;
+    const size_t count = (pad < size) ? ((size - pad) / stride) : 0U;
+    int ok = EXIT_FAILURE;
+
+    if ((buffer != NULL) && (stride > type_size) && (count > 0U)
+        && (clist_init(list, type_size, CLIST_PAYLOAD_IGNORE) == EXIT_SUCCESS))
+    {
+        unsigned char* const p = (unsigned char*)buffer + pad;
+        size_t i = count;
+
+        while (i-- > 0U) {
+            clist_node_t* const node = (clist_node_t*)(void*)(p + (i * stride));
+            node->next = list->pkb;
+            list->pkb = node;
+        }
+        list->zskb = count;
+        list->flags |= 4U;
         ok = EXIT_SUCCESS;
     }
     return ok;
@@ -285,52 +866,152 @@ static void* clist_get(clist_t* list, size_t idx) {
 }
 
 /**
- * @brief Return a pointer to the value stored on \a node
- * @param[in] node The node to extract value from
- * @return The value of \a node or NULL if \a node is NULL
+ * @brief Reset a cursor, so that it holds no position
+ * @param[in] cursor The cursor to reset
+ * @note If \a cursor is NULL, the function does nothing
  */
-static void* clist_get_from_node(clist_node_t* node) {
-    return (node != NULL) ? (node + 1) : NULL;
+static void clist_cursor_reset(clist_cursor_t* cursor) {
+    if (cursor != NULL) {
+        cursor->node = NULL;
+        cursor->idx = 0U;
+    }
 }
 
-/**
- * @brief Set the value stored in the node at position \a idx inside \a list
- * @param[in] list The list to operate with
- * @param[in] idx The index of the element to set
- * @param[in] payload The new value of node
- */
-static void clist_set(clist_t* list, size_t idx, const void* payload) {
-    if (payload != NULL) {
-        clist_node_t* const p = clist_go(list, idx);
-        if (p != NULL) {
-            memcpy(p + 1, payload, list->type_size);
-        }
+static clist_node_t* vnut_cl_walk(clist_node_t* node, size_t from, size_t to)
+{
+    while (from < to) {
+        node = node->next;
+        from++;
+    }
+    while (from > to) {
+        node = node->prev;
+        from--;
     }
+    return node;
 }
 
 /**
- * @brief Set \a payload as value of \a node
- * @param[in] node The node to update
- * @param[in] payload The new value of \a node
- * @param[in] type_size The size of type of the list that contains or will
- *            contain the node
+ * @brief Return the node of index \a idx in \a list, without modifying the
+ *        list
+ * @param[in] list The list to operate with
+ * @param[in] idx The index of the list. Must be less than the list size
+ * @param[in,out] cursor A cursor owned by the caller, or NULL. The walk
+ *                starts from the nearest of the head, the tail and the
+ *                position of the cursor, then the cursor is moved to the
+ *                returned node
+ * @return The node at index \a idx or NULL on errors (\a list is NULL or
+ *         \a idx is >= size of list)
+ * @note The list is only read: many threads can look up the same list at
+ *       the same time, as long as each one uses its own cursor and nobody
+ *       modifies the list meanwhile
  */
-static void clist_set_to_node(clist_node_t* node,
-                              const void* payload,
-                              size_t type_size)
+static const clist_node_t* clist_go_const(const clist_t* list,
+                                          size_t idx,
+                                          clist_cursor_t* cursor)
 {
-    if ((node != NULL) && (payload != NULL) && (type_size > 0U)) {
-        memcpy(node + 1, payload, type_size);
-    }
-}
+    clist_node_t* node = NULL;
 
-static void vnut_cl_insert_node(clist_t* list, size_t idx, clist_node_t* node) {
-    clist_node_t* prev;
-    clist_node_t* const next = (idx < list->size) ? clist_go(list, idx) : NULL;
+    if ((list != NULL) && (idx < list->size)) {
+        const size_t last = list->size - 1U;
+        size_t from;
 
-    if (idx == 0U) {
-        prev = NULL;
-        list->head = node;
+        if (idx <= (last - idx)) {
+            node = list->head;
+            from = 0U;
+        }
+        else {
+            node = list->tail;
+            from = last;
+        }
+
+        if ((cursor != NULL) && (cursor->node != NULL)
+            && (cursor->idx <= last))
+        {
+            const size_t dist = (idx > cursor->idx) ? (idx - cursor->idx)
+                                                    : (cursor->idx - idx);
+            const size_t best = (idx > from) ? (idx - from) : (from - idx);
+            if (dist < best) {
+                node = cursor->node;
+                from = cursor->idx;
+            }
+        }
+
+        node = vnut_cl_walk(node, from, idx);
+
+        if (cursor != NULL) {
+            cursor->node = node;
+            cursor->idx = idx;
+        }
+    }
+
+    return node;
+}
+
+/**
+ * @brief Gives the pointer to the value stored in the node at position \a idx
+ *        inside \a list, without modifying the list
+ * @param[in] list The list to operate with
+ * @param[in] idx The index of the element to retrieve
+ * @param[in,out] cursor A cursor owned by the caller, or NULL. See
+ *                clist_go_const()
+ * @return A pointer to the data contained by node at index \a idx or NULL
+ *         if \a list is NULL or \a idx >= size of list
+ */
+static const void* clist_get_const(const clist_t* list,
+                                   size_t idx,
+                                   clist_cursor_t* cursor)
+{
+    const clist_node_t* const p = clist_go_const(list, idx, cursor);
+    return (p != NULL) ? (const void*)(p + 1) : NULL;
+}
+
+/**
+ * @brief Return a pointer to the value stored on \a node
+ * @param[in] node The node to extract value from
+ * @return The value of \a node or NULL if \a node is NULL
+ */
+static void* clist_get_from_node(clist_node_t* node) {
+    return (node != NULL) ? (node + 1) : NULL;
+}
+
+/**
+ * @brief Set the value stored in the node at position \a idx inside \a list
+ * @param[in] list The list to operate with
+ * @param[in] idx The index of the element to set
+ * @param[in] payload The new value of node
+ */
+static void clist_set(clist_t* list, size_t idx, const void* payload) {
+    if (payload != NULL) {
+        clist_node_t* const p = clist_go(list, idx);
+        if (p != NULL) {
+            memcpy(p + 1, payload, list->type_size);
+        }
+    }
+}
+
+/**
+ * @brief Set \a payload as value of \a node
+ * @param[in] node The node to update
+ * @param[in] payload The new value of \a node
+ * @param[in] type_size The size of type of the list that contains or will
+ *            contain the node
+ */
+static void clist_set_to_node(clist_node_t* node,
+                              const void* payload,
+                              size_t type_size)
+{
+    if ((node != NULL) && (payload != NULL) && (type_size > 0U)) {
+        memcpy(node + 1, payload, type_size);
+    }
+}
+
+static void vnut_cl_insert_node(clist_t* list, size_t idx, clist_node_t* node) {
+    clist_node_t* prev;
+    clist_node_t* const next = (idx < list->size) ? clist_go(list, idx) : NULL;
+
+    if (idx == 0U) {
+        prev = NULL;
+        list->head = node;
     }
     else {
         prev = clist_go(list, idx - 1U);
@@ -348,6 +1029,10 @@ static void vnut_cl_insert_node(clist_t* list, size_t idx, clist_node_t* node) {
     node->next = next;
     node->prev = prev;
 
+    if (list->size >= list->peak) {
+        list->peak = list->size + 1U;
+    }
+
     if ((idx < list->size++) && (idx > 0U)) {
         list->rul = node;
         list->ruly = idx;
@@ -373,17 +1058,7 @@ static int clist_insert(clist_t* list, size_t idx, const void* payload) {
     int ok = EXIT_FAILURE;
 
     if ((list != NULL) && (idx <= list->size)) {
-        clist_node_t* node;
-
-        if (list->zskb > 0U) {
-            node = list->pkb;
-            list->pkb = node->next;
-            list->zskb--;
-        }
-        else {
-            node = (clist_node_t*)malloc(sizeof(clist_node_t)
-                                         + list->type_size);
-        }
+        clist_node_t* const node = vnut_cl_alloc_node(list);
 
         if (node != NULL) {
             if (payload != NULL) {
@@ -423,9 +1098,7 @@ static void clist_erase(clist_t* list, size_t idx, size_t count) {
                 void** const p = (void**)(node + 1);
                 free(*p);
             }
-            node->next = list->pkb;
-            list->pkb = node;
-            list->zskb++;
+            vnut_cl_free_node(list, node);
 
             node = temp;
         }
@@ -445,6 +1118,7 @@ static void clist_erase(clist_t* list, size_t idx, size_t count) {
         }
 
         list->size -= count;
+        vnut_cl_trim(list);
 
         if ((idx > 0U) && ((list->size - idx) > 1U)) {
             list->rul = next;
@@ -453,10 +1127,285 @@ static void clist_erase(clist_t* list, size_t idx, size_t count) {
         }
         else {
             if (list->ruly >= idx) {
-                list->flags &= 1U;
+                list->flags &= ~2U;
+            }
+        }
+    }
+}
+
+static void vnut_cl_link_after(clist_t* list,
+                               clist_node_t* pos,
+                               clist_node_t* node)
+{
+    clist_node_t* const next = (pos != NULL) ? pos->next : list->head;
+
+    node->prev = pos;
+    node->next = next;
+
+    if (pos != NULL) {
+        pos->next = node;
+    }
+    else {
+        list->head = node;
+    }
+
+    if (next != NULL) {
+        next->prev = node;
+    }
+    else {
+        list->tail = node;
+    }
+
+    if (list->size >= list->peak) {
+        list->peak = list->size + 1U;
+    }
+
+    if (pos == NULL) {
+        list->ruly++;
+    }
+    else if (next != NULL) {
+        list->flags &= ~2U;
+    }
+
+    list->size++;
+}
+
+/**
+ * @brief Insert a new node after a given node, in O(1)
+ * @param[in] list The list to operate with
+ * @param[in] node The node after which the new node is inserted. It must
+ *            belong to \a list. If it is NULL, the new node becomes the head
+ * @param[in] payload The value of the new node. Can be NULL, see
+ *            clist_insert()
+ * @return The new node, or NULL if \a list is NULL or not enough memory
+ */
+static clist_node_t* clist_insert_after(clist_t* list,
+                                        clist_node_t* node,
+                                        const void* payload)
+{
+    clist_node_t* added = NULL;
+
+    if (list != NULL) {
+        added = vnut_cl_alloc_node(list);
+        if (added != NULL) {
+            if (payload != NULL) {
+                memcpy(added + 1, payload, list->type_size);
             }
+            vnut_cl_link_after(list, node, added);
+        }
+    }
+
+    return added;
+}
+
+/**
+ * @brief Insert a new node before a given node, in O(1)
+ * @param[in] list The list to operate with
+ * @param[in] node The node before which the new node is inserted. It must
+ *            belong to \a list. If it is NULL, the new node becomes the tail
+ * @param[in] payload The value of the new node. Can be NULL, see
+ *            clist_insert()
+ * @return The new node, or NULL if \a list is NULL or not enough memory
+ */
+static clist_node_t* clist_insert_before(clist_t* list,
+                                         clist_node_t* node,
+                                         const void* payload)
+{
+    return (list != NULL)
+           ? clist_insert_after(list, (node != NULL) ? node->prev
+                                                     : list->tail,
+                                payload)
+           : NULL;
+}
+
+static clist_node_t* vnut_cl_erase_node(clist_t* list, clist_node_t* node) {
+    clist_node_t* const prev = node->prev;
+    clist_node_t* const next = node->next;
+
+    if (prev != NULL) {
+        prev->next = next;
+    }
+    else {
+        list->head = next;
+    }
+
+    if (next != NULL) {
+        next->prev = prev;
+    }
+    else {
+        list->tail = prev;
+    }
+
+    if ((list->flags & CLIST_PAYLOAD_FREE) != 0U) {
+        void** const p = (void**)(node + 1);
+        free(*p);
+    }
+    vnut_cl_free_node(list, node);
+
+    list->size--;
+    if (prev == NULL) {
+        list->ruly--;
+    }
+    else if (next != NULL) {
+        list->flags &= ~2U;
+    }
+    if (list->ruly >= list->size) {
+        list->flags &= ~2U;
+    }
+    vnut_cl_trim(list);
+
+    return next;
+}
+
+/**
+ * @brief Erase a given node from the list, in O(1)
+ * @param[in] list The list to operate with
+ * @param[in] node The node to erase. It must belong to \a list
+ * @return The node following the erased one (NULL if it was the tail), so
+ *         that a list can be filtered while it is traversed:
+ * @code{.c}
+ * clist_node_t* node = clist_head(list);
+ * while (node != NULL) {
+ *     node = must_go(node) ? clist_erase_node(list, node) : node->next;
+ * }
+ * @endcode
+ * @note If \a list or \a node is NULL, the function does nothing and returns
+ *       NULL
+ */
+static clist_node_t* clist_erase_node(clist_t* list, clist_node_t* node) {
+    return ((list != NULL) && (node != NULL)) ? vnut_cl_erase_node(list, node)
+                                              : NULL;
+}
+
+/**
+ * @brief Move a cursor to the node of index \a idx
+ * @param[in] list The list to operate with
+ * @param[in,out] cursor The cursor to move
+ * @param[in] idx The index of the list. Must be less than the list size
+ * @return The node at index \a idx, or NULL on errors (some pointer is NULL
+ *         or \a idx is >= size of list). In this case the cursor is left
+ *         untouched
+ * @note The cost is the distance from the nearest of the cursor, the head
+ *       and the tail. The position cache of the list is not used
+ */
+static clist_node_t* clist_cursor_seek(clist_t* list,
+                                       clist_cursor_t* cursor,
+                                       size_t idx)
+{
+    return (cursor != NULL) ? (clist_node_t*)clist_go_const(list, idx, cursor)
+                            : NULL;
+}
+
+/**
+ * @brief Move a cursor to the next node
+ * @param[in] list The list to operate with
+ * @param[in,out] cursor The cursor to move. If it holds no position, it is
+ *                moved to the head
+ * @return The new node of the cursor, or NULL if the cursor was on the tail
+ *         (or the list is empty): in this case the cursor holds no position
+ * @note If some pointer is NULL, the function does nothing and returns NULL
+ */
+static clist_node_t* clist_cursor_next(clist_t* list, clist_cursor_t* cursor)
+{
+    clist_node_t* node = NULL;
+
+    if ((list != NULL) && (cursor != NULL)) {
+        if (cursor->node != NULL) {
+            node = cursor->node->next;
+            cursor->idx++;
+        }
+        else {
+            node = list->head;
+            cursor->idx = 0U;
+        }
+        cursor->node = node;
+        if (node == NULL) {
+            cursor->idx = 0U;
+        }
+    }
+
+    return node;
+}
+
+/**
+ * @brief Move a cursor to the previous node
+ * @param[in] list The list to operate with
+ * @param[in,out] cursor The cursor to move. If it holds no position, it is
+ *                moved to the tail
+ * @return The new node of the cursor, or NULL if the cursor was on the head
+ *         (or the list is empty): in this case the cursor holds no position
+ * @note If some pointer is NULL, the function does nothing and returns NULL
+ */
+static clist_node_t* clist_cursor_prev(clist_t* list, clist_cursor_t* cursor)
+{
+    clist_node_t* node = NULL;
+
+    if ((list != NULL) && (cursor != NULL)) {
+        if (cursor->node != NULL) {
+            node = cursor->node->prev;
+            cursor->idx--;
+        }
+        else {
+            node = list->tail;
+            cursor->idx = list->size - 1U;
+        }
+        cursor->node = node;
+        if (node == NULL) {
+            cursor->idx = 0U;
+        }
+    }
+
+    return node;
+}
+
+/**
+ * @brief Insert a new node before the node of a cursor, in O(1)
+ * @param[in] list The list to operate with
+ * @param[in,out] cursor The cursor. It keeps its node, whose index grows by
+ *                one. If it holds no position, the new node becomes the tail
+ * @param[in] payload The value of the new node. Can be NULL, see
+ *            clist_insert()
+ * @return The new node, or NULL if some pointer is NULL or not enough memory
+ */
+static clist_node_t* clist_cursor_insert(clist_t* list,
+                                         clist_cursor_t* cursor,
+                                         const void* payload)
+{
+    clist_node_t* added = NULL;
+
+    if (cursor != NULL) {
+        added = clist_insert_before(list, cursor->node, payload);
+        if ((added != NULL) && (cursor->node != NULL)) {
+            cursor->idx++;
         }
     }
+
+    return added;
+}
+
+/**
+ * @brief Erase the node of a cursor, in O(1)
+ * @param[in] list The list to operate with
+ * @param[in,out] cursor The cursor. It moves to the following node, which
+ *                takes the same index. If the erased node was the tail, the
+ *                cursor holds no position
+ * @return The new node of the cursor
+ * @note If some pointer is NULL or the cursor holds no position, the
+ *       function does nothing and returns NULL
+ */
+static clist_node_t* clist_cursor_erase(clist_t* list, clist_cursor_t* cursor)
+{
+    clist_node_t* node = NULL;
+
+    if ((list != NULL) && (cursor != NULL) && (cursor->node != NULL)) {
+        node = vnut_cl_erase_node(list, cursor->node);
+        cursor->node = node;
+        if (node == NULL) {
+            cursor->idx = 0U;
+        }
+    }
+
+    return node;
 }
 
 /**
@@ -478,7 +1427,7 @@ static int clist_resize(clist_t* list, size_t new_size, const void* elem) {
             if (new_size < old_size) {
                 clist_erase(list, new_size, old_size - new_size);
                 if (list->ruly >= new_size) {
-                    list->flags &= 1U;
+                    list->flags &= ~2U;
                 }
             }
             else {
@@ -516,57 +1465,264 @@ static int clist_push_back(clist_t* list, const void* payload) {
                           : EXIT_FAILURE;
 }
 
-/**
- * @brief Remove the first node from the list
- * @param[in] list The list to operate with
- * @note If \a list is NULL or empty, the function does nothing
- */
-static void clist_pop_front(clist_t* list) { clist_erase(list, 0U, 1U); }
+#ifndef CLIST_DEFRAG
+/* add count nodes allocated alone to the free nodes of the list, or none */
+static int vnut_cl_reserve(clist_t* list, size_t count) {
+    size_t i = 0U;
+    int ok = EXIT_SUCCESS;
 
-/**
- * @brief Remove the last node from the list
- * @param[in] list The list to operate with
- * @note If \a list is NULL or empty, the function does nothing
- */
-static void clist_pop_back(clist_t* list) {
-    if (list != NULL) {
-        clist_erase(list, list->size - 1U, 1U);
+    while ((ok == EXIT_SUCCESS) && (i < count)) {
+        clist_node_t* const node = vnut_cl_heap_node(list);
+        if (node != NULL) {
+            node->next = list->pkb;
+            list->pkb = node;
+            i++;
+        }
+        else {
+            ok = EXIT_FAILURE;
+        }
     }
-}
 
-/**
- * @brief Clear a list, removing all its elements
- * @param[in] list The list to clear
- * @note If \a list is NULL or empty, the function does nothing
- */
-static void clist_clear(clist_t* list) {
-    if (list != NULL) {
-        clist_erase(list, 0U, list->size);
+    if (ok == EXIT_SUCCESS) {
+        list->zskb += count;
     }
-}
-
-/**
- * @brief Free all non-necessary memory allocated by list
- * @param[in] list The list to shrink
- * @note If \a list is NULL or empty, the function does nothing
- * @note Calling this function may save some memory, but may also decrease
- *       performance if the list will grow after this call
- */
-static void clist_shrink_to_fit(clist_t* list) {
-    if (list != NULL) {
-        clist_node_t* node = list->pkb;
-        while (node != NULL) {
-            clist_node_t* const next = node->next;
-            free(node);
-            node = next;
+    else {
+        while (i-- > 0U) {
+            clist_node_t* const node = list->pkb;
+            list->pkb = node->next;
+            vnut_cl_release(list, node);
         }
-        list->pkb = NULL;
-        list->zskb = 0U;
     }
+
+    return ok;
 }
+#endif
 
 /**
- * @brief Destroy an initialized list
+ * @brief Append an array of values at the end of the list
+ * @param[in] list The list to operate with
+ * @param[in] data The values to append, stored contiguously. Can be NULL.
+ *            In this case, the values of the new nodes will be undefined
+ * @param[in] count The number of values to append
+ * @retval EXIT_SUCCESS If all the values are added
+ * @retval EXIT_FAILURE If \a list is NULL or not enough memory. In this case
+ *         the list is left untouched
+ * @note The free nodes kept by the list are reused first, then the missing
+ *       nodes are allocated and all are linked in a single pass. The missing
+ *       nodes take one arena allocation for a list using an arena and, if
+ *       #CLIST_DEFRAG is defined, one block otherwise: like the blocks of
+ *       clist_defragment(), that block is freed when its last node is
+ *       released, and its nodes can be spliced to other lists like any other
+ *       node
+ */
+static int clist_append_array(clist_t* list, const void* data, size_t count)
+{
+    int ok = EXIT_FAILURE;
+
+    if ((list != NULL) && (count <= ((size_t)-1 - list->size))) {
+        const size_t stride = VNUT_CL_ROUND(vnut_cl_bytes(list));
+        const size_t reused = (list->zskb < count) ? list->zskb : count;
+        const size_t fresh = count - reused;
+        size_t pooled = reused;
+#ifdef CLIST_DEFRAG
+        vnut_cl_slab_t* slab = NULL;
+#endif
+        unsigned char* block = NULL;
+
+        if (fresh == 0U) {
+            ok = EXIT_SUCCESS;
+        }
+        else if ((list->flags & 4U) != 0U) {
+            block = NULL;
+        }
+#ifdef CLIST_ARENA
+        else if (list->arena != NULL) {
+            if (((fresh * stride) / stride) == fresh) {
+                block = (unsigned char*)carena_alloc(list->arena,
+                                                     fresh * stride);
+            }
+        }
+#endif
+        else {
+#ifdef CLIST_DEFRAG
+            slab = vnut_cl_new_slab(list, fresh);
+            if (slab != NULL) {
+                block = (unsigned char*)slab + VNUT_CL_SLAB_HEADER;
+            }
+#else
+            /* nodes allocated alone, added to the free nodes of the list */
+            ok = vnut_cl_reserve(list, fresh);
+            pooled = count;
+#endif
+        }
+
+        if ((ok == EXIT_SUCCESS) || (block != NULL)) {
+            const unsigned char* src = (const unsigned char*)data;
+            clist_node_t* prev = list->tail;
+            size_t i;
+
+            for (i = 0U; i < count; i++) {
+                clist_node_t* node;
+
+                if (i < pooled) {
+                    node = list->pkb;
+                    list->pkb = node->next;
+                }
+                else {
+                    node = (clist_node_t*)(void*)block;
+                    block += stride;
+#ifdef CLIST_DEFRAG
+                    if (slab != NULL) {
+                        *vnut_cl_tag(list, node) = slab;
+                    }
+#endif
+                }
+
+                if (src != NULL) {
+                    memcpy(node + 1, src, list->type_size);
+                    src += list->type_size;
+                }
+
+                node->prev = prev;
+                if (prev != NULL) {
+                    prev->next = node;
+                }
+                else {
+                    list->head = node;
+                }
+                prev = node;
+            }
+
+            if (prev != NULL) {
+                prev->next = NULL;
+                list->tail = prev;
+            }
+
+            list->zskb -= pooled;
+            list->size += count;
+            if (list->size > list->peak) {
+                list->peak = list->size;
+            }
+            ok = EXIT_SUCCESS;
+        }
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Remove the first node from the list
+ * @param[in] list The list to operate with
+ * @note If \a list is NULL or empty, the function does nothing
+ */
+static void clist_pop_front(clist_t* list) { clist_erase(list, 0U, 1U); }
+
+/**
+ * @brief Remove the last node from the list
+ * @param[in] list The list to operate with
+ * @note If \a list is NULL or empty, the function does nothing
+ */
+static void clist_pop_back(clist_t* list) {
+    if (list != NULL) {
+        clist_erase(list, list->size - 1U, 1U);
+    }
+}
+
+/**
+ * @brief Clear a list, removing all its elements
+ * @param[in] list The list to clear
+ * @note If \a list is NULL or empty, the function does nothing
+ */
+static void clist_clear(clist_t* list) {
+    if (list != NULL) {
+        clist_erase(list, 0U, list->size);
+    }
+}
+
+/**
+ * @brief Free all non-necessary memory allocated by list
+ * @param[in] list The list to shrink
+ * @note If \a list is NULL or empty, the function does nothing
+ * @note Calling this function may save some memory, but may also decrease
+ *       performance if the list will grow after this call
+ * @note The free nodes of a list using an arena are only forgotten, their
+ *       memory is reclaimed by carena_reset()
+ * @note A pass of clist_defragment_step() in progress is abandoned when the
+ *       list is empty (see #CLIST_DEFRAG)
+ * @note Lists initialized by clist_init_ext() keep all their nodes
+ */
+static void clist_shrink_to_fit(clist_t* list) {
+    if ((list != NULL) && ((list->flags & 4U) == 0U)) {
+        clist_node_t* node = (list->arena == NULL) ? list->pkb : NULL;
+        while (node != NULL) {
+            clist_node_t* const next = node->next;
+            vnut_cl_release(list, node);
+            node = next;
+        }
+        list->pkb = NULL;
+        list->zskb = 0U;
+
+#ifdef CLIST_DEFRAG
+        if ((list->size == 0U) && (list->dslab != NULL)) {
+            vnut_cl_defrag_end(list);
+        }
+#endif
+    }
+}
+
+/**
+ * @brief Limit the free nodes a list keeps for reuse
+ * @param[in] list The list to configure
+ * @param[in] max_nodes The maximum number of free nodes to keep, or
+ *            #CLIST_RETAIN_ALL
+ * @param[in] max_bytes The maximum number of bytes of free nodes to keep
+ *            (nodes and payloads), or #CLIST_RETAIN_ALL
+ * @param[in] decay Zero to disable, otherwise the list also tracks the peak
+ *            of its size, lowered by 1/2^decay of itself at every erasing
+ *            call, and keeps only the free nodes needed to grow back to it.
+ *            So the memory left by a spike is released progressively, while
+ *            a list regularly growing and shrinking keeps recycling its nodes
+ * @note Limits are applied immediately and then by every function removing
+ *       elements. By default all free nodes are kept until
+ *       clist_shrink_to_fit() or clist_destroy()
+ * @note If \a list is NULL, the function does nothing
+ */
+static void clist_set_retention(clist_t* list,
+                                size_t max_nodes,
+                                size_t max_bytes,
+                                unsigned int decay)
+{
+    if (list != NULL) {
+        const size_t per_node = max_bytes / vnut_cl_bytes(list);
+        list->keep = (per_node < max_nodes) ? per_node : max_nodes;
+        list->decay = (decay < (sizeof(size_t) * 8U)) ? decay : 0U;
+        vnut_cl_trim(list);
+    }
+}
+
+/**
+ * @brief Return the number of free nodes a list keeps for reuse
+ * @param[in] list The list to operate with
+ * @return The number of free nodes or zero if \a list is NULL
+ * @sa clist_set_retention()
+ */
+static size_t clist_cached_nodes(const clist_t* list) {
+    return (list != NULL) ? list->zskb : 0U;
+}
+
+/**
+ * @brief Return the memory held by the free nodes a list keeps for reuse
+ * @param[in] list The list to operate with
+ * @return The number of bytes of the free nodes, payload included, or zero if
+ *         \a list is NULL
+ */
+static size_t clist_cached_bytes(const clist_t* list) {
+    return (list != NULL)
+           ? (list->zskb * vnut_cl_bytes(list)) : 0U;
+}
+
+/**
+ * @brief Destroy an initialized list
  * @param[in] list The list to destroy
  * @note If \a list is NULL, the function does nothing
  */
@@ -592,6 +1748,32 @@ static void clist_delete(clist_t** pList) {
     }
 }
 
+/* the link followed by a walk: next from the head, prev from the tail */
+static clist_node_t** vnut_cl_link(clist_node_t* node, int backward) {
+    return (backward != 0) ? &node->prev : &node->next;
+}
+
+/* return the node CLIST_PREFETCH_DISTANCE nodes after node in the walk,
+   prefetching the nodes in between, or NULL when prefetching is disabled */
+static clist_node_t* vnut_cl_prefetch_from(clist_node_t* node, int backward) {
+    size_t i;
+
+    for (i = 0U; (node != NULL) && (i < CLIST_PREFETCH_DISTANCE); i++) {
+        node = *vnut_cl_link(node, backward);
+        CLIST_PREFETCH(node);
+    }
+
+    return (CLIST_PREFETCH_DISTANCE > 0U) ? node : NULL;
+}
+
+static clist_node_t* vnut_cl_prefetch_next(clist_node_t* ahead, int backward) {
+    if (ahead != NULL) {
+        ahead = *vnut_cl_link(ahead, backward);
+        CLIST_PREFETCH(ahead);
+    }
+    return ahead;
+}
+
 /**
  * @brief Execute passed callback to each element of the list
  * @param[in] list The list to operate with
@@ -600,36 +1782,166 @@ static void clist_delete(clist_t** pList) {
 static void clist_foreach(clist_t* list, clist_foreach_cb_t f) {
     if ((list != NULL) && (f != NULL)) {
         clist_node_t* node = list->head;
+        clist_node_t* ahead = vnut_cl_prefetch_from(node, 0);
         while (node != NULL) {
             f(node + 1);
             node = node->next;
+            ahead = vnut_cl_prefetch_next(ahead, 0);
         }
     }
 }
 
 /**
- * @brief Filter the list, removing elements according to given predicate
+ * @brief Execute passed callback to each element of the list, with a context
  * @param[in] list The list to operate with
- * @param[in] f The predicate to apply to each element of the list. After this
- *              call, the list will contain \b only those elements for each
- *              the predicate function return non-zero
+ * @param[in] f The callback to run on all elements of the list
+ * @param[in] ctx The context passed to every call of \a f. Can be NULL
+ * @note See #CLIST_FOREACH for a loop avoiding a call per element
  */
-static void clist_filter(clist_t* list, clist_filter_cb_t f) {
+static void clist_foreach_ctx(clist_t* list,
+                              clist_foreach_ctx_cb_t f,
+                              void* ctx)
+{
     if ((list != NULL) && (f != NULL)) {
-        const size_t len = list->size;
-        size_t i, idx, del_idx = len;
-        for (i = 0U, idx = len - 1U; i < len; i++, idx--) {
-            if (f(clist_go(list, idx) + 1) == 0) {
-                clist_erase(list, idx, 1U);
-                del_idx = i;
+        clist_node_t* node = list->head;
+        clist_node_t* ahead = vnut_cl_prefetch_from(node, 0);
+        while (node != NULL) {
+            f(node + 1, ctx);
+            node = node->next;
+            ahead = vnut_cl_prefetch_next(ahead, 0);
+        }
+    }
+}
+
+/* walks from the head, or from the tail if backward is non-zero: the links
+   are mirrored, so kept is always the last node kept in walk order */
+static void vnut_cl_filter(clist_t* list,
+                           clist_filter_ctx_cb_t f,
+                           void* ctx,
+                           int backward)
+{
+    if ((list != NULL) && (f != NULL)) {
+        clist_node_t** const first = (backward != 0) ? &list->tail
+                                                     : &list->head;
+        clist_node_t** const end = (backward != 0) ? &list->head
+                                                   : &list->tail;
+        clist_node_t* node = *first;
+        clist_node_t* ahead = vnut_cl_prefetch_from(node, backward);
+        clist_node_t* kept = NULL;
+        clist_node_t* dropped = NULL;
+        clist_node_t* last = NULL;
+        size_t count = 0U;
+
+        while (node != NULL) {
+            clist_node_t* const next = *vnut_cl_link(node, backward);
+
+            if (f(node + 1, ctx) != 0) {
+                /* links are written only where something was dropped */
+                if (*vnut_cl_link(node, !backward) != kept) {
+                    *vnut_cl_link(node, !backward) = kept;
+                    if (kept != NULL) {
+                        *vnut_cl_link(kept, backward) = node;
+                    }
+                    else {
+                        *first = node;
+                    }
+                }
+                kept = node;
+            }
+            else {
+                if (dropped == NULL) {
+                    last = node;
+                }
+                node->next = dropped;
+                dropped = node;
+                count++;
             }
+
+            node = next;
+            ahead = vnut_cl_prefetch_next(ahead, backward);
         }
-        if (list->ruly >= del_idx) {
-            list->flags &= 1U;
+
+        if (count > 0U) {
+            if (kept != NULL) {
+                *vnut_cl_link(kept, backward) = NULL;
+            }
+            else {
+                *first = NULL;
+            }
+            *end = kept;
+
+            if ((list->flags & CLIST_PAYLOAD_FREE) != 0U) {
+                for (node = dropped; node != NULL; node = node->next) {
+                    void** const p = (void**)(node + 1);
+                    free(*p);
+                }
+            }
+
+#ifdef CLIST_THREAD_CACHE
+            (void)last;
+            while (dropped != NULL) {
+                node = dropped->next;
+                vnut_cl_free_node(list, dropped);
+                dropped = node;
+            }
+#else
+            last->next = list->pkb;
+            list->pkb = dropped;
+            list->zskb += count;
+#endif
+
+            list->size -= count;
+            list->flags &= ~2U;
+            vnut_cl_trim(list);
         }
     }
 }
 
+/**
+ * @brief Filter the list with a context, removing elements according to
+ *        given predicate
+ * @param[in] list The list to operate with
+ * @param[in] f The predicate to apply to each element of the list, from the
+ *              head to the tail. After this call, the list will contain
+ *              \b only those elements for each the predicate function return
+ *              non-zero. It must not access the list
+ * @param[in] ctx The context passed to every call of \a f. Can be NULL
+ * @note The list is walked once: rejected nodes are unlinked on the way, and
+ *       released all together at the end (their values first, if
+ *       #CLIST_PAYLOAD_FREE was passed)
+ */
+static void clist_filter_ctx(clist_t* list,
+                             clist_filter_ctx_cb_t f,
+                             void* ctx)
+{
+    vnut_cl_filter(list, f, ctx, 0);
+}
+
+typedef struct {
+    clist_filter_cb_t f;
+} vnut_cl_filter_t;
+
+static int vnut_cl_filter_cb(void* value, void* ctx) {
+    return ((vnut_cl_filter_t*)ctx)->f(value);
+}
+
+/**
+ * @brief Filter the list, removing elements according to given predicate
+ * @param[in] list The list to operate with
+ * @param[in] f The predicate to apply to each element of the list, from the
+ *              tail to the head. After this call, the list will contain
+ *              \b only those elements for each the predicate function return
+ *              non-zero
+ * @note See clist_filter_ctx(), which walks the other way round
+ */
+static void clist_filter(clist_t* list, clist_filter_cb_t f) {
+    if (f != NULL) {
+        vnut_cl_filter_t c;
+        c.f = f;
+        vnut_cl_filter(list, &vnut_cl_filter_cb, &c, 1);
+    }
+}
+
 /**
  * @brief Moves one or more nodes from a list to another (different) list
  * @param[in] source The source list, elements will be removed from this list
@@ -639,8 +1951,8 @@ static void clist_filter(clist_t* list, clist_filter_cb_t f) {
  * @param[in] pos The index of the new inserted elements in \a dest list
  * @note If \a source and \a dest are the same list or there is some NULL
  *       pointer or some index is not valid, the function does nothing
- * @warning The type_size and the initialization flags of the two lists must
- *          be equal, or no splice will be done
+ * @warning The type_size, the initialization flags and the arena of the two
+ *          lists must be equal, or no splice will be done
  *
  */
 static void clist_splice(clist_t* source, size_t idx, size_t count,
@@ -649,7 +1961,8 @@ static void clist_splice(clist_t* source, size_t idx, size_t count,
     if ((source != NULL) && (dest != NULL) && (source != dest)
         && ((idx + count) <= source->size) && (pos <= dest->size)
         && (source->type_size == dest->type_size)
-        && ((source->flags & 1U) == (dest->flags & 1U))
+        && ((source->flags & 5U) == (dest->flags & 5U))
+        && (source->arena == dest->arena)
         && (count > 0U))
     {
         clist_node_t* first;
@@ -679,7 +1992,7 @@ static void clist_splice(clist_t* source, size_t idx, size_t count,
         source->size -= count;
 
         if (source->ruly >= idx) {
-            source->flags &= 1U;
+            source->flags &= ~2U;
         }
 
         if (pos == 0U) {
@@ -714,13 +2027,447 @@ static void clist_splice(clist_t* source, size_t idx, size_t count,
         }
 
         dest->size += count;
+        if (dest->size > dest->peak) {
+            dest->peak = dest->size;
+        }
 
         if (dest->ruly >= pos) {
-            dest->flags &= 1U;
+            dest->flags &= ~2U;
         }
     }
 }
 
+/**
+ * @brief Move a range of nodes, from \a first to \a last included, after a
+ *        given node of another (or the same) list
+ * @param[in] source The list containing the range
+ * @param[in] first The first node of the range
+ * @param[in] last The last node of the range. It must follow \a first or be
+ *            \a first itself
+ * @param[in] dest The destination list. It can be \a source
+ * @param[in] after The node of \a dest after which the range is moved, or
+ *            NULL to move it at the head. If \a dest is \a source, it must
+ *            not be inside the range
+ * @note The nodes are relinked in O(1). When the lists are different, the
+ *       range is walked once to update their sizes
+ * @note If some pointer is NULL or the two lists have different type_size,
+ *       initialization flags or arena, the function does nothing
+ */
+static void clist_splice_nodes(clist_t* source,
+                               clist_node_t* first,
+                               clist_node_t* last,
+                               clist_t* dest,
+                               clist_node_t* after)
+{
+    if ((source != NULL) && (dest != NULL) && (first != NULL) && (last != NULL)
+        && (source->type_size == dest->type_size)
+        && ((source->flags & 5U) == (dest->flags & 5U))
+        && (source->arena == dest->arena)
+        && (after != last) && ((after == NULL) || (after->next != first)))
+    {
+        clist_node_t* const prev = first->prev;
+        clist_node_t* const next = last->next;
+        clist_node_t* dnext;
+
+        if (source != dest) {
+            size_t count = 1U;
+            clist_node_t* node;
+            for (node = first; node != last; node = node->next) {
+                count++;
+            }
+            source->size -= count;
+            dest->size += count;
+            if (dest->size > dest->peak) {
+                dest->peak = dest->size;
+            }
+        }
+
+        if (prev != NULL) {
+            prev->next = next;
+        }
+        else {
+            source->head = next;
+        }
+
+        if (next != NULL) {
+            next->prev = prev;
+        }
+        else {
+            source->tail = prev;
+        }
+
+        dnext = (after != NULL) ? after->next : dest->head;
+        first->prev = after;
+        last->next = dnext;
+
+        if (after != NULL) {
+            after->next = first;
+        }
+        else {
+            dest->head = first;
+        }
+
+        if (dnext != NULL) {
+            dnext->prev = last;
+        }
+        else {
+            dest->tail = last;
+        }
+
+        source->flags &= ~2U;
+        dest->flags &= ~2U;
+    }
+}
+
+static clist_node_t* vnut_cl_merge(clist_node_t* a,
+                                   clist_node_t* b,
+                                   clist_cmp_cb_t cmp)
+{
+    clist_node_t head;
+    clist_node_t* tail = &head;
+
+    while ((a != NULL) && (b != NULL)) {
+        if (cmp(b + 1, a + 1) < 0) {
+            tail->next = b;
+            b = b->next;
+        }
+        else {
+            tail->next = a;
+            a = a->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = (a != NULL) ? a : b;
+
+    return head.next;
+}
+
+static void vnut_cl_relink(clist_t* list, clist_node_t* head) {
+    clist_node_t* prev = NULL;
+
+    list->head = head;
+    while (head != NULL) {
+        head->prev = prev;
+        prev = head;
+        head = head->next;
+    }
+    list->tail = prev;
+    list->flags &= ~2U;
+}
+
+/**
+ * @brief Sort a list, relinking its nodes
+ * @param[in] list The list to sort
+ * @param[in] cmp The comparison function, receiving pointers to the values
+ * @note This is a stable bottom-up merge sort: O(n log n) comparisons, no
+ *       memory allocated and no value moved, only the links of the nodes.
+ *       Sorted runs of 2^k nodes are kept in a fixed array of one pointer per
+ *       bit of size_t and merged as soon as two of them have the same length,
+ *       so the merged nodes are usually still in cache
+ * @note If \a list or \a cmp is NULL, the function does nothing
+ */
+static void clist_sort(clist_t* list, clist_cmp_cb_t cmp) {
+    if ((list != NULL) && (cmp != NULL) && (list->size > 1U)) {
+        clist_node_t* pending[sizeof(size_t) * 8U];
+        clist_node_t* node = list->head;
+        clist_node_t* sorted = NULL;
+        size_t k;
+
+        for (k = 0U; k < (sizeof(pending) / sizeof(pending[0])); k++) {
+            pending[k] = NULL;
+        }
+
+        while (node != NULL) {
+            clist_node_t* run = node;
+            node = node->next;
+            run->next = NULL;
+            for (k = 0U; pending[k] != NULL; k++) {
+                run = vnut_cl_merge(pending[k], run, cmp);
+                pending[k] = NULL;
+            }
+            pending[k] = run;
+        }
+
+        for (k = 0U; k < (sizeof(pending) / sizeof(pending[0])); k++) {
+            if (pending[k] != NULL) {
+                sorted = vnut_cl_merge(pending[k], sorted, cmp);
+            }
+        }
+
+        vnut_cl_relink(list, sorted);
+    }
+}
+
+/**
+ * @brief Merge two sorted lists, moving all the nodes of \a src into \a dst
+ * @param[in] dst The destination list, sorted according to \a cmp
+ * @param[in] src The source list, sorted according to \a cmp. It will be
+ *            empty after this call
+ * @param[in] cmp The comparison function, receiving pointers to the values
+ * @note The merge is stable: on ties, the nodes of \a dst come first. No
+ *       memory is allocated and no value is moved
+ * @note If \a dst and \a src are the same list, some pointer is NULL or the
+ *       two lists have different type_size, initialization flags or arena,
+ *       the function does nothing
+ */
+static void clist_merge(clist_t* dst, clist_t* src, clist_cmp_cb_t cmp) {
+    if ((dst != NULL) && (src != NULL) && (dst != src) && (cmp != NULL)
+        && (dst->type_size == src->type_size)
+        && ((dst->flags & 5U) == (src->flags & 5U))
+        && (dst->arena == src->arena)
+        && (src->size > 0U))
+    {
+        if (dst->tail != NULL) {
+            dst->tail->next = NULL;
+        }
+        vnut_cl_relink(dst, vnut_cl_merge(dst->head, src->head, cmp));
+        dst->size += src->size;
+        if (dst->size > dst->peak) {
+            dst->peak = dst->size;
+        }
+        src->head = src->tail = NULL;
+        src->size = 0U;
+        src->flags &= ~2U;
+    }
+}
+
+#ifdef CLIST_DEFRAG
+static int vnut_cl_defrag_begin(clist_t* list) {
+    list->dslab = vnut_cl_new_slab(list, list->size);
+    list->dpos = (list->dslab != NULL)
+                 ? ((unsigned char*)list->dslab + VNUT_CL_SLAB_HEADER) : NULL;
+    list->didx = 0U;
+
+    return (list->dslab != NULL) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Move some nodes of a list to a contiguous block, in list order.
+ *        Available if #CLIST_DEFRAG is defined
+ * @param[in] list The list to defragment
+ * @param[in] count The maximum number of nodes to move by this call
+ * @return The number of nodes still to move, zero when the pass is complete
+ * @note The first call of a pass allocates a block for all the nodes of the
+ *       list. Every call copies the next \a count nodes to it, relinks them
+ *       and releases the old ones. The progress of the pass is the index of
+ *       the next node to move, that is the size of the list less the value
+ *       returned by the last call
+ * @note The list can be used between two calls, as long as no node is
+ *       inserted, erased or moved before the progress of the pass: a node
+ *       already moved would be moved again, or a node would be skipped. The
+ *       list stays valid anyway, only the pass ends earlier or leaves some
+ *       nodes out of the block. Nodes inserted after the progress are moved
+ *       too, if there is room in the block
+ * @note If \a list is NULL, empty, uses an arena or a static pool, or the
+ *       block cannot be allocated, the function does nothing and returns
+ *       zero
+ * @warning The moved nodes change address: the pointers to them and to
+ *          their values obtained before the call are no longer valid
+ * @sa clist_defragment()
+ */
+static size_t clist_defragment_step(clist_t* list, size_t count) {
+    size_t remaining = 0U;
+
+    if ((list != NULL) && (list->arena == NULL) && ((list->flags & 4U) == 0U)
+        && (list->size > 0U)
+        && ((list->dslab != NULL)
+            || (vnut_cl_defrag_begin(list) == EXIT_SUCCESS)))
+    {
+        const size_t bytes = sizeof(clist_node_t) + list->type_size;
+        const size_t stride = VNUT_CL_ROUND(vnut_cl_bytes(list));
+
+        while ((count > 0U) && (list->didx < list->size)
+               && (list->dpos < list->dslab->end))
+        {
+            clist_node_t* const old = clist_go(list, list->didx);
+            clist_node_t* const node = (clist_node_t*)(void*)list->dpos;
+
+            memcpy(node, old, bytes);
+            *vnut_cl_tag(list, node) = list->dslab;
+
+            if (node->prev != NULL) {
+                node->prev->next = node;
+            }
+            else {
+                list->head = node;
+            }
+
+            if (node->next != NULL) {
+                node->next->prev = node;
+            }
+            else {
+                list->tail = node;
+            }
+
+            list->rul = node;
+            list->ruly = list->didx;
+            list->flags |= 2U;
+
+            vnut_cl_release(list, old);
+            list->dpos += stride;
+            list->didx++;
+            count--;
+        }
+
+        if ((list->didx < list->size) && (list->dpos < list->dslab->end)) {
+            remaining = list->size - list->didx;
+        }
+        else {
+            vnut_cl_defrag_end(list);
+        }
+    }
+
+    return remaining;
+}
+
+/**
+ * @brief Relayout all the nodes of a list in one contiguous block, in list
+ *        order, so that traversing the list walks memory sequentially.
+ *        Available if #CLIST_DEFRAG is defined
+ * @param[in] list The list to defragment
+ * @retval EXIT_SUCCESS If the list is defragmented (or empty)
+ * @retval EXIT_FAILURE If \a list is NULL, uses an arena or a static pool, or
+ *         not enough memory
+ * @note The old nodes and the free nodes kept for reuse are released. A
+ *       pass of clist_defragment_step() in progress is abandoned
+ * @note A block is freed when its last node is released, by whatever list
+ *       holds it at that time: the nodes of a defragmented list can be
+ *       spliced like any other node
+ * @warning All the pointers to nodes and values of the list obtained before
+ *          the call are no longer valid
+ */
+static int clist_defragment(clist_t* list) {
+    int ok = EXIT_FAILURE;
+
+    if ((list != NULL) && (list->arena == NULL)
+        && ((list->flags & 4U) == 0U))
+    {
+        if (list->dslab != NULL) {
+            vnut_cl_defrag_end(list);
+        }
+        clist_shrink_to_fit(list);
+        if ((list->size == 0U)
+            || (vnut_cl_defrag_begin(list) == EXIT_SUCCESS))
+        {
+            (void)clist_defragment_step(list, list->size);
+            ok = EXIT_SUCCESS;
+        }
+    }
+
+    return ok;
+}
+#endif
+
+/**
+ * @name Unchecked functions
+ * Speed oriented versions of the most used functions, following the
+ * philosophy of cvector.h: no pointer is NULL-checked and no index is
+ * checked, the caller guarantees validity. They are always inlined and
+ * share the state of the list with the checked functions, so the two
+ * families can be freely mixed on the same list
+ * @{
+ */
+
+/**
+ * @brief Unchecked clist_go()
+ * @param[in] list The list to operate with. Must not be NULL
+ * @param[in] idx The index of the node. Must be less than the list size
+ * @return The node at index \a idx
+ * @note Indexes next to the last one accessed are reached in a couple of
+ *       instructions, the others walk the list like clist_go()
+ */
+CLIST_INLINE clist_node_t* clist_u_go(clist_t* list, size_t idx) {
+    const size_t delta = (idx - list->ruly) + 1U;
+    clist_node_t* node;
+
+    if (CLIST_LIKELY(((list->flags & 2U) != 0U) && (delta <= 2U))) {
+        node = list->rul;
+        if (delta == 2U) {
+            node = node->next;
+        }
+        else if (delta == 0U) {
+            node = node->prev;
+        }
+        list->rul = node;
+        list->ruly = idx;
+    }
+    else {
+        node = clist_go(list, idx);
+    }
+
+    return node;
+}
+
+/**
+ * @brief Unchecked clist_get()
+ * @param[in] list The list to operate with. Must not be NULL
+ * @param[in] idx The index of the element. Must be less than the list size
+ * @return A pointer to the value of the node at index \a idx
+ */
+CLIST_INLINE void* clist_u_get(clist_t* list, size_t idx) {
+    return clist_u_go(list, idx) + 1;
+}
+
+/**
+ * @brief Unchecked clist_push_front()
+ * @param[in] list The list to operate with. Must not be NULL
+ * @param[in] payload The value of the node to add. Must not be NULL
+ * @retval EXIT_SUCCESS If element is added
+ * @retval EXIT_FAILURE If not enough memory to add element
+ */
+CLIST_INLINE int clist_u_push_front(clist_t* list, const void* payload) {
+    clist_node_t* const node = vnut_cl_alloc_node(list);
+    int ok = EXIT_FAILURE;
+
+    if (CLIST_LIKELY(node != NULL)) {
+        memcpy(node + 1, payload, list->type_size);
+        vnut_cl_link_after(list, NULL, node);
+        ok = EXIT_SUCCESS;
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Unchecked clist_push_back()
+ * @param[in] list The list to operate with. Must not be NULL
+ * @param[in] payload The value of the node to add. Must not be NULL
+ * @retval EXIT_SUCCESS If element is added
+ * @retval EXIT_FAILURE If not enough memory to add element
+ */
+CLIST_INLINE int clist_u_push_back(clist_t* list, const void* payload) {
+    clist_node_t* const node = vnut_cl_alloc_node(list);
+    int ok = EXIT_FAILURE;
+
+    if (CLIST_LIKELY(node != NULL)) {
+        memcpy(node + 1, payload, list->type_size);
+        vnut_cl_link_after(list, list->tail, node);
+        ok = EXIT_SUCCESS;
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Unchecked clist_pop_front()
+ * @param[in] list The list to operate with. Must not be NULL nor empty
+ */
+CLIST_INLINE void clist_u_pop_front(clist_t* list) {
+    (void)vnut_cl_erase_node(list, list->head);
+}
+
+/**
+ * @brief Unchecked clist_pop_back()
+ * @param[in] list The list to operate with. Must not be NULL nor empty
+ */
+CLIST_INLINE void clist_u_pop_back(clist_t* list) {
+    (void)vnut_cl_erase_node(list, list->tail);
+}
+
+/**
+ * @}
+ */
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,93 @@
+/*
+clang -Ofast -oclu clu_bench.c
+gcc -Ofast -oclu clu_bench.c
+
+compare the times printed for the checked clist functions and for their
+unchecked clist_u_* versions on your env. Both lists are checked to hold the
+same values
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "clist.h"
+
+#define NUM_ELEMS 1000000
+#define BENCH_LOOP 20
+
+static double now(void) {
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+int main(void)
+{
+    clist_t l;
+    double start, t_push, t_go, t_pop;
+    long sum = 0L, usum = 0L;
+    int i, k;
+
+    clist_init(&l, sizeof(int), CLIST_PAYLOAD_IGNORE);
+
+    /* allocate all the nodes once, both variants then recycle them */
+    clist_resize(&l, 2U * NUM_ELEMS, NULL);
+    clist_clear(&l);
+
+    t_push = t_go = t_pop = 0.0;
+    for (k = 0; k < BENCH_LOOP; k++) {
+        start = now();
+        for (i = 0; i < NUM_ELEMS; i++) {
+            clist_push_back(&l, &i);
+            clist_push_front(&l, &i);
+        }
+        t_push += now() - start;
+
+        start = now();
+        for (i = 0; i < (2 * NUM_ELEMS); i++) {
+            sum += *CLIST_PTR(&l, (size_t)i, int);
+        }
+        t_go += now() - start;
+
+        start = now();
+        for (i = 0; i < NUM_ELEMS; i++) {
+            clist_pop_back(&l);
+            clist_pop_front(&l);
+        }
+        t_pop += now() - start;
+    }
+    printf("checked:   push %.3f s, go %.3f s, pop %.3f s\n",
+           t_push, t_go, t_pop);
+
+    t_push = t_go = t_pop = 0.0;
+    for (k = 0; k < BENCH_LOOP; k++) {
+        start = now();
+        for (i = 0; i < NUM_ELEMS; i++) {
+            clist_u_push_back(&l, &i);
+            clist_u_push_front(&l, &i);
+        }
+        t_push += now() - start;
+
+        start = now();
+        for (i = 0; i < (2 * NUM_ELEMS); i++) {
+            usum += *(int*)clist_u_get(&l, (size_t)i);
+        }
+        t_go += now() - start;
+
+        start = now();
+        for (i = 0; i < NUM_ELEMS; i++) {
+            clist_u_pop_back(&l);
+            clist_u_pop_front(&l);
+        }
+        t_pop += now() - start;
+    }
+    printf("unchecked: push %.3f s, go %.3f s, pop %.3f s\n",
+           t_push, t_go, t_pop);
+
+    if ((sum != usum) || (clist_size(&l) != 0U)) {
+        puts("impossible");
+        exit(-1);
+    }
+
+    clist_destroy(&l);
+
+    return EXIT_SUCCESS;
+}
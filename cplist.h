@@ -0,0 +1,508 @@
+/**
+ * @file      cplist.h
+ * @version   1.0
+ * @brief     CPList header-only pooled list with 32-bit links for C89 language
+ * @date      Sat Oct 17 01:52:19 2026
+ * @author    Michele Pes
+ * @copyright BSD-3-Clause
+ *
+ * This file offers a double-linked list whose nodes live in a single pool
+ * and are linked by 32-bit indexes into the pool instead of pointers. On
+ * 64-bit systems the links of a node take 8 bytes instead of the 16 of a
+ * clist_node_t, and nodes are packed contiguously. Since links are indexes,
+ * the pool is relocatable: it grows by realloc and can be copied or
+ * serialized as it is, together with the list structure.
+ * Nodes are identified by their index. #CPLIST_NIL plays the role of NULL.
+ * Like CList, all pointers are NULL-checked and all functions fail or do
+ * nothing on errors, but indexes of nodes must be valid nodes of the list.
+ * Elements are simply discarded on removal
+ */
+
+#ifndef CPLIST_H_
+#define CPLIST_H_
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @typedef cplist_idx_t
+ * The index of a node in the pool. It must be a 32-bit unsigned integer
+ */
+typedef unsigned int cplist_idx_t;
+
+/**
+ * @def CPLIST_NIL
+ * The index of no node: it ends the list and is returned on errors
+ */
+#define CPLIST_NIL ((cplist_idx_t)0xFFFFFFFFUL)
+
+/**
+ * @def CPLIST_MIN_CAPACITY
+ * The number of nodes allocated by the first growth of a list
+ */
+#ifndef CPLIST_MIN_CAPACITY
+#define CPLIST_MIN_CAPACITY 16U
+#endif
+
+typedef struct {
+    cplist_idx_t next;
+    cplist_idx_t prev;
+} vnut_pl_link_t;
+
+typedef struct {
+    unsigned char* pool;
+    size_t type_size;
+    size_t stride;
+    cplist_idx_t head;
+    cplist_idx_t tail;
+    cplist_idx_t free;
+    cplist_idx_t size;
+    cplist_idx_t used;
+    cplist_idx_t capacity;
+    int fixed;
+} cplist_t;
+
+static vnut_pl_link_t* vnut_pl_link(const cplist_t* list, cplist_idx_t i) {
+    return (vnut_pl_link_t*)(void*)(list->pool + ((size_t)i * list->stride));
+}
+
+static size_t vnut_pl_stride(size_t type_size) {
+    size_t align = 1U;
+
+    /* the payload is aligned as its size suggests, up to 8 bytes */
+    while ((align < 8U) && ((type_size & align) == 0U)) {
+        align <<= 1U;
+    }
+    if (align < sizeof(cplist_idx_t)) {
+        align = sizeof(cplist_idx_t);
+    }
+
+    return (sizeof(vnut_pl_link_t) + type_size + (align - 1U))
+           & ~(align - 1U);
+}
+
+static void vnut_pl_init(cplist_t* list, size_t type_size) {
+    list->pool = NULL;
+    list->type_size = type_size;
+    list->stride = vnut_pl_stride(type_size);
+    list->head = list->tail = list->free = CPLIST_NIL;
+    list->size = list->used = list->capacity = 0U;
+    list->fixed = 0;
+}
+
+/**
+ * @brief Initialize a list whose pool is allocated by malloc
+ * @param[in] list The list to initialize
+ * @param[in] type_size The size of type of elements of the list
+ *            (ex.: sizeof(int))
+ * @param[in] capacity The number of nodes to allocate now. Can be zero
+ * @retval EXIT_SUCCESS If list is correctly initialized
+ * @retval EXIT_FAILURE If \a list is NULL, \a type_size is zero or not enough
+ *         memory
+ * @note The pool doubles when it is full, so pointers to values are valid
+ *       only until the next insertion. Indexes of nodes stay valid
+ */
+static int cplist_init(cplist_t* list, size_t type_size, size_t capacity) {
+    int ok = EXIT_FAILURE;
+
+    if ((list != NULL) && (type_size > 0U)
+        && (type_size < ((size_t)-1 / 2U)) && (capacity < CPLIST_NIL))
+    {
+        vnut_pl_init(list, type_size);
+        ok = EXIT_SUCCESS;
+        if (capacity > 0U) {
+            const size_t bytes = capacity * list->stride;
+            list->pool = ((bytes / list->stride) == capacity)
+                         ? (unsigned char*)malloc(bytes) : NULL;
+            if (list->pool != NULL) {
+                list->capacity = (cplist_idx_t)capacity;
+            }
+            else {
+                ok = EXIT_FAILURE;
+            }
+        }
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Initialize a list whose pool is a user buffer, so that the list
+ *        never calls malloc nor free
+ * @param[in] list The list to initialize
+ * @param[in] buffer The memory of the pool. It must outlive the list and is
+ *            never freed by the list. It should be aligned as the elements
+ * @param[in] size The size in \b bytes of \a buffer
+ * @param[in] type_size The size of type of elements of the list
+ * @retval EXIT_SUCCESS If list is correctly initialized
+ * @retval EXIT_FAILURE If \a list or \a buffer is NULL, \a type_size is zero
+ *         or \a buffer cannot hold a single node
+ * @note Adding elements fails with EXIT_FAILURE (or #CPLIST_NIL) when the
+ *       pool is full
+ */
+static int cplist_init_ext(cplist_t* list,
+                           void* buffer,
+                           size_t size,
+                           size_t type_size)
+{
+    int ok = EXIT_FAILURE;
+
+    if ((list != NULL) && (buffer != NULL) && (type_size > 0U)
+        && (type_size < ((size_t)-1 / 2U)))
+    {
+        size_t count;
+
+        vnut_pl_init(list, type_size);
+        count = size / list->stride;
+        if (count > 0U) {
+            list->pool = (unsigned char*)buffer;
+            list->capacity = (count < CPLIST_NIL) ? (cplist_idx_t)count
+                                                  : (CPLIST_NIL - 1U);
+            list->fixed = 1;
+            ok = EXIT_SUCCESS;
+        }
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Destroy a list, freeing its pool unless it is a user buffer
+ * @param[in] list The list to destroy
+ * @note If \a list is NULL, the function does nothing
+ */
+static void cplist_destroy(cplist_t* list) {
+    if (list != NULL) {
+        if (list->fixed == 0) {
+            free(list->pool);
+            list->pool = NULL;
+            list->capacity = 0U;
+        }
+        list->head = list->tail = list->free = CPLIST_NIL;
+        list->size = list->used = 0U;
+    }
+}
+
+/**
+ * @brief Return the number of elements of the list
+ * @param[in] list The list to operate with
+ * @return The size of the list or zero if \a list is NULL
+ */
+static size_t cplist_size(const cplist_t* list) {
+    return (list != NULL) ? list->size : 0U;
+}
+
+/**
+ * @brief Tell if list is empty
+ * @param[in] list The list to operate with
+ * @retval 1 if \a list is NULL or it is empty
+ * @retval 0 if \a list is not NULL and has some elements
+ */
+static int cplist_empty(const cplist_t* list) {
+    return ((list != NULL) && (list->size > 0U)) ? 0 : 1;
+}
+
+/**
+ * @brief Return the number of nodes the pool can hold without growing
+ * @param[in] list The list to operate with
+ * @return The capacity of the pool or zero if \a list is NULL
+ */
+static size_t cplist_capacity(const cplist_t* list) {
+    return (list != NULL) ? list->capacity : 0U;
+}
+
+/**
+ * @brief Return the first node of the list
+ * @param[in] list The list to operate with
+ * @return The index of the first node, or #CPLIST_NIL if the list is empty
+ *         or \a list is NULL
+ */
+static cplist_idx_t cplist_head(const cplist_t* list) {
+    return (list != NULL) ? list->head : CPLIST_NIL;
+}
+
+/**
+ * @brief Return the last node of the list
+ * @param[in] list The list to operate with
+ * @return The index of the last node, or #CPLIST_NIL if the list is empty or
+ *         \a list is NULL
+ */
+static cplist_idx_t cplist_tail(const cplist_t* list) {
+    return (list != NULL) ? list->tail : CPLIST_NIL;
+}
+
+/**
+ * @brief Return the node following a given one
+ * @param[in] list The list to operate with
+ * @param[in] node A node of the list
+ * @return The index of the next node, or #CPLIST_NIL if \a node is the tail,
+ *         \a node is #CPLIST_NIL or \a list is NULL
+ */
+static cplist_idx_t cplist_next(const cplist_t* list, cplist_idx_t node) {
+    return ((list != NULL) && (node != CPLIST_NIL))
+           ? vnut_pl_link(list, node)->next : CPLIST_NIL;
+}
+
+/**
+ * @brief Return the node preceding a given one
+ * @param[in] list The list to operate with
+ * @param[in] node A node of the list
+ * @return The index of the previous node, or #CPLIST_NIL if \a node is the
+ *         head, \a node is #CPLIST_NIL or \a list is NULL
+ */
+static cplist_idx_t cplist_prev(const cplist_t* list, cplist_idx_t node) {
+    return ((list != NULL) && (node != CPLIST_NIL))
+           ? vnut_pl_link(list, node)->prev : CPLIST_NIL;
+}
+
+/**
+ * @brief Return a pointer to the value stored on a node
+ * @param[in] list The list to operate with
+ * @param[in] node A node of the list
+ * @return The value of \a node, or NULL if \a node is #CPLIST_NIL or \a list
+ *         is NULL
+ * @note The pointer is valid until the pool grows
+ */
+static void* cplist_get(cplist_t* list, cplist_idx_t node) {
+    return ((list != NULL) && (node != CPLIST_NIL))
+           ? (void*)(vnut_pl_link(list, node) + 1) : NULL;
+}
+
+/**
+ * @brief Grow the pool to hold at least \a capacity nodes
+ * @param[in] list The list to operate with
+ * @param[in] capacity The number of nodes the pool must hold
+ * @retval EXIT_SUCCESS If the pool holds at least \a capacity nodes
+ * @retval EXIT_FAILURE If \a list is NULL, its pool is a user buffer or not
+ *         enough memory. In this case the pool is left untouched
+ */
+static int cplist_reserve(cplist_t* list, size_t capacity) {
+    int ok = EXIT_FAILURE;
+
+    if (list != NULL) {
+        if (capacity <= list->capacity) {
+            ok = EXIT_SUCCESS;
+        }
+        else if ((list->fixed == 0) && (capacity < CPLIST_NIL)
+                 && (((capacity * list->stride) / list->stride) == capacity))
+        {
+            unsigned char* const p =
+                (unsigned char*)realloc(list->pool, capacity * list->stride);
+            if (p != NULL) {
+                list->pool = p;
+                list->capacity = (cplist_idx_t)capacity;
+                ok = EXIT_SUCCESS;
+            }
+        }
+    }
+
+    return ok;
+}
+
+static cplist_idx_t vnut_pl_alloc(cplist_t* list) {
+    cplist_idx_t node = CPLIST_NIL;
+
+    if (list->free != CPLIST_NIL) {
+        node = list->free;
+        list->free = vnut_pl_link(list, node)->next;
+    }
+    else {
+        if ((list->used == list->capacity) && (list->fixed == 0)) {
+            const size_t cap = list->capacity;
+            size_t grown = (cap < CPLIST_MIN_CAPACITY) ? CPLIST_MIN_CAPACITY
+                                                       : (cap * 2U);
+            if (grown >= CPLIST_NIL) {
+                grown = CPLIST_NIL - 1U;
+            }
+            /* fall back to a single node when doubling is not possible */
+            if (cplist_reserve(list, grown) != EXIT_SUCCESS) {
+                (void)cplist_reserve(list, cap + 1U);
+            }
+        }
+        if (list->used < list->capacity) {
+            node = list->used++;
+        }
+    }
+
+    return node;
+}
+
+/**
+ * @brief Insert a new node after a given node, in O(1)
+ * @param[in] list The list to operate with
+ * @param[in] node The node after which the new node is inserted, or
+ *            #CPLIST_NIL to insert the new node at the head
+ * @param[in] payload The value of the new node. Can be NULL. In this case,
+ *            the value of node will be undefined
+ * @return The index of the new node, or #CPLIST_NIL if \a list is NULL or the
+ *         pool cannot hold another node
+ */
+static cplist_idx_t cplist_insert_after(cplist_t* list,
+                                        cplist_idx_t node,
+                                        const void* payload)
+{
+    cplist_idx_t added = CPLIST_NIL;
+
+    if (list != NULL) {
+        added = vnut_pl_alloc(list);
+        if (added != CPLIST_NIL) {
+            vnut_pl_link_t* const l = vnut_pl_link(list, added);
+            const cplist_idx_t next = (node != CPLIST_NIL)
+                                      ? vnut_pl_link(list, node)->next
+                                      : list->head;
+
+            if (payload != NULL) {
+                memcpy(l + 1, payload, list->type_size);
+            }
+
+            l->prev = node;
+            l->next = next;
+
+            if (node != CPLIST_NIL) {
+                vnut_pl_link(list, node)->next = added;
+            }
+            else {
+                list->head = added;
+            }
+
+            if (next != CPLIST_NIL) {
+                vnut_pl_link(list, next)->prev = added;
+            }
+            else {
+                list->tail = added;
+            }
+
+            list->size++;
+        }
+    }
+
+    return added;
+}
+
+/**
+ * @brief Insert a new node before a given node, in O(1)
+ * @param[in] list The list to operate with
+ * @param[in] node The node before which the new node is inserted, or
+ *            #CPLIST_NIL to insert the new node at the tail
+ * @param[in] payload The value of the new node. Can be NULL, see
+ *            cplist_insert_after()
+ * @return The index of the new node, or #CPLIST_NIL if \a list is NULL or the
+ *         pool cannot hold another node
+ */
+static cplist_idx_t cplist_insert_before(cplist_t* list,
+                                         cplist_idx_t node,
+                                         const void* payload)
+{
+    return (list != NULL)
+           ? cplist_insert_after(list, (node != CPLIST_NIL)
+                                       ? vnut_pl_link(list, node)->prev
+                                       : list->tail,
+                                 payload)
+           : CPLIST_NIL;
+}
+
+/**
+ * @brief Add a node at the beginning of the list
+ * @param[in] list The list to operate with
+ * @param[in] payload The value of the node to add. Can be NULL
+ * @retval EXIT_SUCCESS If element is added
+ * @retval EXIT_FAILURE If \a list is NULL or the pool cannot hold another
+ *         node
+ */
+static int cplist_push_front(cplist_t* list, const void* payload) {
+    return (cplist_insert_after(list, CPLIST_NIL, payload) != CPLIST_NIL)
+           ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Add a node at the end of the list
+ * @param[in] list The list to operate with
+ * @param[in] payload The value of the node to add. Can be NULL
+ * @retval EXIT_SUCCESS If element is added
+ * @retval EXIT_FAILURE If \a list is NULL or the pool cannot hold another
+ *         node
+ */
+static int cplist_push_back(cplist_t* list, const void* payload) {
+    return (cplist_insert_before(list, CPLIST_NIL, payload) != CPLIST_NIL)
+           ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Erase a given node from the list, in O(1)
+ * @param[in] list The list to operate with
+ * @param[in] node The node to erase. It must belong to \a list
+ * @return The node following the erased one (#CPLIST_NIL if it was the tail)
+ * @note The node goes back to the pool, which never shrinks
+ * @note If \a list is NULL or \a node is #CPLIST_NIL, the function does
+ *       nothing and returns #CPLIST_NIL
+ */
+static cplist_idx_t cplist_erase(cplist_t* list, cplist_idx_t node) {
+    cplist_idx_t next = CPLIST_NIL;
+
+    if ((list != NULL) && (node != CPLIST_NIL)) {
+        vnut_pl_link_t* const l = vnut_pl_link(list, node);
+        const cplist_idx_t prev = l->prev;
+        next = l->next;
+
+        if (prev != CPLIST_NIL) {
+            vnut_pl_link(list, prev)->next = next;
+        }
+        else {
+            list->head = next;
+        }
+
+        if (next != CPLIST_NIL) {
+            vnut_pl_link(list, next)->prev = prev;
+        }
+        else {
+            list->tail = prev;
+        }
+
+        l->next = list->free;
+        list->free = node;
+        list->size--;
+    }
+
+    return next;
+}
+
+/**
+ * @brief Remove the first node from the list
+ * @param[in] list The list to operate with
+ * @note If \a list is NULL or empty, the function does nothing
+ */
+static void cplist_pop_front(cplist_t* list) {
+    (void)cplist_erase(list, cplist_head(list));
+}
+
+/**
+ * @brief Remove the last node from the list
+ * @param[in] list The list to operate with
+ * @note If \a list is NULL or empty, the function does nothing
+ */
+static void cplist_pop_back(cplist_t* list) {
+    (void)cplist_erase(list, cplist_tail(list));
+}
+
+/**
+ * @brief Clear a list, removing all its elements in O(1)
+ * @param[in] list The list to clear
+ * @note The pool keeps its capacity. If \a list is NULL, the function does
+ *       nothing
+ */
+static void cplist_clear(cplist_t* list) {
+    if (list != NULL) {
+        list->head = list->tail = list->free = CPLIST_NIL;
+        list->size = list->used = 0U;
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,363 @@
+/**
+ * @file      cpool.h
+ * @version   1.0
+ * @brief     CPool header-only work-stealing thread pool for C89 language
+ * @date      Sat Oct 17 01:25:09 2026
+ * @author    Michele Pes
+ * @copyright BSD-3-Clause
+ *
+ * This file offers a small thread pool used to run the parallel algorithms of
+ * the library (see cvector_par.h), and usable to run any set of tasks.
+ * Every worker owns a Chase-Lev deque: the owner pushes and pops tasks at the
+ * bottom without locks, while idle workers steal from the top of the deques
+ * of the others. The thread calling cpool_run() takes part in the work as the
+ * first worker, so a pool of N workers starts N-1 threads.
+ * It requires POSIX threads and the GCC/Clang atomic builtins
+ */
+
+#ifndef CPOOL_H_
+#define CPOOL_H_
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+
+#if !defined(__GNUC__) && !defined(__clang__)
+#error "cpool.h requires GCC or Clang atomic builtins"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def CPOOL_DEQUE_SIZE
+ * The number of tasks every worker can hold in its deque. It must be a power
+ * of two. Tasks that do not fit are executed immediately by the thread
+ * spawning them
+ */
+#ifndef CPOOL_DEQUE_SIZE
+#define CPOOL_DEQUE_SIZE 1024
+#endif
+
+/**
+ * @def CPOOL_CACHE_LINE
+ * The size of a cache line, used to keep per-worker data apart
+ */
+#ifndef CPOOL_CACHE_LINE
+#define CPOOL_CACHE_LINE 64
+#endif
+
+/**
+ * @typedef cpool_fn_t
+ * Prototype of the function executed by a task
+ */
+typedef void (*cpool_fn_t)(void* arg);
+
+/**
+ * @brief A task: a function and its argument. Tasks are never copied by the
+ *        pool, so they must stay valid until they are executed
+ */
+typedef struct {
+    cpool_fn_t fn;
+    void* arg;
+} cpool_task_t;
+
+typedef struct {
+    long top;
+    char pad0[CPOOL_CACHE_LINE - sizeof(long)];
+    long bottom;
+    char pad1[CPOOL_CACHE_LINE - sizeof(long)];
+    cpool_task_t* buf[CPOOL_DEQUE_SIZE];
+    struct vnut_pool_t* pool;
+    pthread_t thread;
+    unsigned int id;
+    unsigned int seed;
+} vnut_worker_t;
+
+typedef struct vnut_pool_t {
+    vnut_worker_t* workers;
+    unsigned int size;
+    size_t pending;
+    unsigned int gen;
+    int stop;
+    pthread_key_t key;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    pthread_mutex_t run_lock;
+} cpool_t;
+
+static int vnut_deque_push(vnut_worker_t* w, cpool_task_t* task) {
+    const long b = __atomic_load_n(&w->bottom, __ATOMIC_RELAXED);
+    const long t = __atomic_load_n(&w->top, __ATOMIC_ACQUIRE);
+    int ok = 0;
+
+    if ((b - t) < (long)CPOOL_DEQUE_SIZE) {
+        __atomic_store_n(&w->buf[b & (CPOOL_DEQUE_SIZE - 1)], task,
+                         __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        __atomic_store_n(&w->bottom, b + 1, __ATOMIC_RELAXED);
+        ok = 1;
+    }
+
+    return ok;
+}
+
+static cpool_task_t* vnut_deque_pop(vnut_worker_t* w) {
+    const long b = __atomic_load_n(&w->bottom, __ATOMIC_RELAXED) - 1;
+    cpool_task_t* task = NULL;
+    long t;
+
+    __atomic_store_n(&w->bottom, b, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    t = __atomic_load_n(&w->top, __ATOMIC_RELAXED);
+
+    if (t <= b) {
+        task = __atomic_load_n(&w->buf[b & (CPOOL_DEQUE_SIZE - 1)],
+                               __ATOMIC_RELAXED);
+        if (t == b) {
+            if (!__atomic_compare_exchange_n(&w->top, &t, t + 1, 0,
+                                             __ATOMIC_SEQ_CST,
+                                             __ATOMIC_RELAXED))
+            {
+                task = NULL;
+            }
+            __atomic_store_n(&w->bottom, b + 1, __ATOMIC_RELAXED);
+        }
+    }
+    else {
+        __atomic_store_n(&w->bottom, b + 1, __ATOMIC_RELAXED);
+    }
+
+    return task;
+}
+
+static cpool_task_t* vnut_deque_steal(vnut_worker_t* w) {
+    long t = __atomic_load_n(&w->top, __ATOMIC_ACQUIRE);
+    cpool_task_t* task = NULL;
+    long b;
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    b = __atomic_load_n(&w->bottom, __ATOMIC_ACQUIRE);
+
+    if (t < b) {
+        task = __atomic_load_n(&w->buf[t & (CPOOL_DEQUE_SIZE - 1)],
+                               __ATOMIC_RELAXED);
+        if (!__atomic_compare_exchange_n(&w->top, &t, t + 1, 0,
+                                         __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+        {
+            task = NULL;
+        }
+    }
+
+    return task;
+}
+
+static void vnut_pool_exec(cpool_t* pool, cpool_task_t* task) {
+    (*task->fn)(task->arg);
+    (void)__atomic_sub_fetch(&pool->pending, 1U, __ATOMIC_ACQ_REL);
+}
+
+static cpool_task_t* vnut_pool_find(cpool_t* pool, vnut_worker_t* w) {
+    cpool_task_t* task = vnut_deque_pop(w);
+
+    if ((task == NULL) && (pool->size > 1U)) {
+        unsigned int i;
+        w->seed = (w->seed * 1103515245U) + 12345U;
+        for (i = 0U; (task == NULL) && (i < pool->size); i++) {
+            const unsigned int v = ((w->seed >> 16) + i) % pool->size;
+            if (v != w->id) {
+                task = vnut_deque_steal(&pool->workers[v]);
+            }
+        }
+    }
+
+    return task;
+}
+
+static void* vnut_pool_thread(void* arg) {
+    vnut_worker_t* const w = (vnut_worker_t*)arg;
+    cpool_t* const pool = w->pool;
+    unsigned int gen = 0U;
+    int stop = 0;
+
+    (void)pthread_setspecific(pool->key, w);
+
+    while (stop == 0) {
+        (void)pthread_mutex_lock(&pool->lock);
+        while ((pool->gen == gen) && (pool->stop == 0)) {
+            (void)pthread_cond_wait(&pool->cond, &pool->lock);
+        }
+        gen = pool->gen;
+        stop = pool->stop;
+        (void)pthread_mutex_unlock(&pool->lock);
+
+        while (__atomic_load_n(&pool->pending, __ATOMIC_ACQUIRE) > 0U) {
+            cpool_task_t* const task = vnut_pool_find(pool, w);
+            if (task != NULL) {
+                vnut_pool_exec(pool, task);
+            }
+            else {
+                (void)sched_yield();
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Destroy a pool, stopping its threads
+ * @param[in] pool The pool to destroy
+ * @warning No cpool_run() must be running on \a pool
+ */
+static void cpool_destroy(cpool_t* pool) {
+    unsigned int i;
+
+    (void)pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    (void)pthread_cond_broadcast(&pool->cond);
+    (void)pthread_mutex_unlock(&pool->lock);
+
+    for (i = 1U; i < pool->size; i++) {
+        (void)pthread_join(pool->workers[i].thread, NULL);
+    }
+
+    (void)pthread_key_delete(pool->key);
+    (void)pthread_mutex_destroy(&pool->run_lock);
+    (void)pthread_cond_destroy(&pool->cond);
+    (void)pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    pool->workers = NULL;
+}
+
+/**
+ * @brief Initialize a pool
+ * @param[in] pool The pool to initialize
+ * @param[in] size The number of workers, including the thread calling
+ *            cpool_run(). So \a size - 1 threads are started. Pass 1 to run
+ *            all tasks on the calling thread
+ * @retval EXIT_SUCCESS If pool is correctly initialized
+ * @retval EXIT_FAILURE If \a size is zero or not enough resources are
+ *         available
+ */
+static int cpool_init(cpool_t* pool, unsigned int size) {
+    int ok = EXIT_FAILURE;
+
+    pool->workers = (size > 0U)
+                    ? (vnut_worker_t*)malloc(size * sizeof(vnut_worker_t))
+                    : NULL;
+
+    if (pool->workers != NULL) {
+        unsigned int i;
+
+        pool->size = 1U;
+        pool->pending = 0U;
+        pool->gen = 0U;
+        pool->stop = 0;
+        (void)pthread_key_create(&pool->key, NULL);
+        (void)pthread_mutex_init(&pool->lock, NULL);
+        (void)pthread_cond_init(&pool->cond, NULL);
+        (void)pthread_mutex_init(&pool->run_lock, NULL);
+
+        for (i = 0U; i < size; i++) {
+            vnut_worker_t* const w = &pool->workers[i];
+            w->top = w->bottom = 0;
+            w->pool = pool;
+            w->id = i;
+            w->seed = i + 1U;
+        }
+
+        ok = EXIT_SUCCESS;
+        for (i = 1U; (ok == EXIT_SUCCESS) && (i < size); i++) {
+            vnut_worker_t* const w = &pool->workers[i];
+            if (pthread_create(&w->thread, NULL, &vnut_pool_thread, w) == 0) {
+                pool->size++;
+            }
+            else {
+                cpool_destroy(pool);
+                ok = EXIT_FAILURE;
+            }
+        }
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Return the number of workers of a pool
+ * @param[in] pool The pool
+ * @return The number of workers, including the thread calling cpool_run()
+ */
+static unsigned int cpool_size(const cpool_t* pool) {
+    return pool->size;
+}
+
+/**
+ * @brief Execute tasks on the pool and wait for their completion
+ * @param[in] pool The pool
+ * @param[in] tasks The tasks to execute
+ * @param[in] count The number of tasks
+ * @note The calling thread executes tasks too. Calls from different threads
+ *       are serialized, and the function must not be called by a task
+ *       (use cpool_spawn() instead)
+ */
+static void cpool_run(cpool_t* pool, cpool_task_t* tasks, size_t count) {
+    vnut_worker_t* const w = &pool->workers[0];
+    size_t next = 0U;
+
+    (void)pthread_mutex_lock(&pool->run_lock);
+    (void)pthread_setspecific(pool->key, w);
+
+    __atomic_store_n(&pool->pending, count, __ATOMIC_RELEASE);
+    while ((next < count) && (vnut_deque_push(w, &tasks[next]) != 0)) {
+        next++;
+    }
+
+    if (pool->size > 1U) {
+        (void)pthread_mutex_lock(&pool->lock);
+        pool->gen++;
+        (void)pthread_cond_broadcast(&pool->cond);
+        (void)pthread_mutex_unlock(&pool->lock);
+    }
+
+    while (__atomic_load_n(&pool->pending, __ATOMIC_ACQUIRE) > 0U) {
+        cpool_task_t* const task = vnut_pool_find(pool, w);
+        if (task != NULL) {
+            vnut_pool_exec(pool, task);
+        }
+        else {
+            (void)sched_yield();
+        }
+        while ((next < count) && (vnut_deque_push(w, &tasks[next]) != 0)) {
+            next++;
+        }
+    }
+
+    (void)pthread_setspecific(pool->key, NULL);
+    (void)pthread_mutex_unlock(&pool->run_lock);
+}
+
+/**
+ * @brief Add a task to the running cpool_run(), from inside a task
+ * @param[in] pool The pool executing the calling task
+ * @param[in] task The task to add. It will be executed before cpool_run()
+ *            returns, possibly by another worker
+ * @note The task is pushed on the deque of the calling worker, where idle
+ *       workers can steal it. If the deque is full, the task is executed
+ *       immediately
+ */
+static void cpool_spawn(cpool_t* pool, cpool_task_t* task) {
+    vnut_worker_t* const w = (vnut_worker_t*)pthread_getspecific(pool->key);
+
+    (void)__atomic_add_fetch(&pool->pending, 1U, __ATOMIC_ACQ_REL);
+    if (vnut_deque_push(w, task) == 0) {
+        vnut_pool_exec(pool, task);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
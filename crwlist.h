@@ -0,0 +1,241 @@
+/**
+ * @file      crwlist.h
+ * @version   1.0
+ * @brief     CRWList header-only readers/writer locked list for C89 language
+ * @date      Sat Oct 17 01:53:32 2026
+ * @author    Michele Pes
+ * @copyright BSD-3-Clause
+ *
+ * This file wraps a CList with a readers/writer lock, so that many threads
+ * can look up the same list in parallel while writers get exclusive access.
+ * Lookups never touch the position cache of the list (see clist_go_const()):
+ * every reading thread owns a crwlist_reader_t holding its own cursor, which
+ * is forgotten automatically when the list has been modified meanwhile.
+ * Values are copied out under the lock, since a concurrent writer may erase
+ * the node holding them.
+ * It requires POSIX.1-2001 readers/writer locks: in strict ISO C modes (such
+ * as -std=c89) they are hidden unless _POSIX_C_SOURCE is defined to 200112L
+ * (or _XOPEN_SOURCE to 600) for the whole translation unit, so pass
+ * -D_POSIX_C_SOURCE=200112L to the compiler
+ */
+
+#ifndef CRWLIST_H_
+#define CRWLIST_H_
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "clist.h"
+
+/* pthread_rwlock_t is declared only if the feature macro is set before
+   the first system header, which a header cannot do */
+#if !defined(_POSIX_READER_WRITER_LOCKS) || (_POSIX_READER_WRITER_LOCKS <= 0)
+#error "crwlist.h requires POSIX readers/writer locks"
+#endif
+#if defined(__STRICT_ANSI__) \
+    && (!defined(_POSIX_C_SOURCE) || (_POSIX_C_SOURCE < 200112L))
+#error "crwlist.h requires -D_POSIX_C_SOURCE=200112L in strict ISO C modes"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    pthread_rwlock_t lock;
+    clist_t list;
+    size_t gen;
+} crwlist_t;
+
+/**
+ * @brief The state of a reading thread: its cursor, and the version of the
+ *        list the cursor refers to
+ */
+typedef struct {
+    clist_cursor_t cursor;
+    size_t gen;
+} crwlist_reader_t;
+
+/**
+ * @brief Initialize a locked list
+ * @param[in] rw The list to initialize
+ * @param[in] type_size See explanation on clist_init()
+ * @param[in] dynamic See explanation on clist_init()
+ * @retval EXIT_SUCCESS If list is correctly initialized
+ * @retval EXIT_FAILURE If \a rw is NULL, the arguments are not valid for
+ *         clist_init() or the lock cannot be created
+ */
+static int crwlist_init(crwlist_t* rw, size_t type_size, unsigned int dynamic)
+{
+    int ok = EXIT_FAILURE;
+
+    if ((rw != NULL)
+        && (clist_init(&rw->list, type_size, dynamic) == EXIT_SUCCESS)
+        && (pthread_rwlock_init(&rw->lock, NULL) == 0))
+    {
+        rw->gen = 0U;
+        ok = EXIT_SUCCESS;
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Destroy a locked list
+ * @param[in] rw The list to destroy
+ * @warning No other thread must be using the list
+ */
+static void crwlist_destroy(crwlist_t* rw) {
+    if (rw != NULL) {
+        clist_destroy(&rw->list);
+        (void)pthread_rwlock_destroy(&rw->lock);
+    }
+}
+
+/**
+ * @brief Initialize the state of a reading thread
+ * @param[in] reader The state to initialize
+ */
+static void crwlist_reader_init(crwlist_reader_t* reader) {
+    clist_cursor_reset(&reader->cursor);
+    reader->gen = 0U;
+}
+
+/**
+ * @brief Lock the list in shared mode, to read it directly
+ * @param[in] rw The locked list
+ * @return The wrapped list. Only the functions not modifying it (such as
+ *         clist_go_const() and clist_get_const()) may be called until
+ *         crwlist_unlock()
+ */
+static const clist_t* crwlist_read_lock(crwlist_t* rw) {
+    (void)pthread_rwlock_rdlock(&rw->lock);
+    return &rw->list;
+}
+
+/**
+ * @brief Lock the list in exclusive mode, to modify it directly
+ * @param[in] rw The locked list
+ * @return The wrapped list, which can be used freely until crwlist_unlock().
+ *         The cursors of all readers are considered outdated
+ */
+static clist_t* crwlist_write_lock(crwlist_t* rw) {
+    (void)pthread_rwlock_wrlock(&rw->lock);
+    rw->gen++;
+    return &rw->list;
+}
+
+/**
+ * @brief Release a lock taken by crwlist_read_lock() or crwlist_write_lock()
+ * @param[in] rw The locked list
+ */
+static void crwlist_unlock(crwlist_t* rw) {
+    (void)pthread_rwlock_unlock(&rw->lock);
+}
+
+/**
+ * @brief Return the size of the list
+ * @param[in] rw The locked list
+ * @return The number of elements, read in shared mode
+ */
+static size_t crwlist_size(crwlist_t* rw) {
+    const size_t size = clist_size(crwlist_read_lock(rw));
+    crwlist_unlock(rw);
+    return size;
+}
+
+/**
+ * @brief Copy the value of an element
+ * @param[in] rw The locked list
+ * @param[in,out] reader The state of the calling thread, or NULL. Its cursor
+ *                makes lookups near the previous one O(distance)
+ * @param[in] idx The index of the element
+ * @param[out] value Where the value is copied
+ * @retval EXIT_SUCCESS If \a idx is a valid index
+ * @retval EXIT_FAILURE If \a idx >= size of list. \a value is untouched
+ * @note The list is locked in shared mode: readers run in parallel
+ */
+static int crwlist_get(crwlist_t* rw,
+                       crwlist_reader_t* reader,
+                       size_t idx,
+                       void* value)
+{
+    clist_cursor_t* cursor = NULL;
+    const clist_t* list;
+    const void* p;
+
+    list = crwlist_read_lock(rw);
+    if (reader != NULL) {
+        if (reader->gen != rw->gen) {
+            clist_cursor_reset(&reader->cursor);
+            reader->gen = rw->gen;
+        }
+        cursor = &reader->cursor;
+    }
+    p = clist_get_const(list, idx, cursor);
+    if (p != NULL) {
+        memcpy(value, p, list->type_size);
+    }
+    crwlist_unlock(rw);
+
+    return (p != NULL) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Set the value of an element
+ * @param[in] rw The locked list
+ * @param[in] idx The index of the element
+ * @param[in] value The new value, see clist_set()
+ * @note The list is locked in exclusive mode
+ */
+static void crwlist_set(crwlist_t* rw, size_t idx, const void* value) {
+    clist_set(crwlist_write_lock(rw), idx, value);
+    crwlist_unlock(rw);
+}
+
+/**
+ * @brief Insert an element
+ * @param[in] rw The locked list
+ * @param[in] idx The index where the element is inserted
+ * @param[in] value The value of the element, see clist_insert()
+ * @retval EXIT_SUCCESS If element is added
+ * @retval EXIT_FAILURE If \a idx > size of list or not enough memory
+ * @note The list is locked in exclusive mode
+ */
+static int crwlist_insert(crwlist_t* rw, size_t idx, const void* value) {
+    const int ok = clist_insert(crwlist_write_lock(rw), idx, value);
+    crwlist_unlock(rw);
+    return ok;
+}
+
+/**
+ * @brief Add an element at the end of the list
+ * @param[in] rw The locked list
+ * @param[in] value The value of the element, see clist_insert()
+ * @retval EXIT_SUCCESS If element is added
+ * @retval EXIT_FAILURE If not enough memory
+ * @note The list is locked in exclusive mode
+ */
+static int crwlist_push_back(crwlist_t* rw, const void* value) {
+    const int ok = clist_push_back(crwlist_write_lock(rw), value);
+    crwlist_unlock(rw);
+    return ok;
+}
+
+/**
+ * @brief Erase one or more elements
+ * @param[in] rw The locked list
+ * @param[in] idx The index of the first element to remove
+ * @param[in] count The number of elements to remove, see clist_erase()
+ * @note The list is locked in exclusive mode
+ */
+static void crwlist_erase(crwlist_t* rw, size_t idx, size_t count) {
+    clist_erase(crwlist_write_lock(rw), idx, count);
+    crwlist_unlock(rw);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,255 @@
+/**
+ * @file      cshardmap.h
+ * @version   1.0
+ * @brief     CShardMap header-only concurrent hash table library for C89
+ * @date      Sat Oct 17 01:22:02 2026
+ * @author    Michele Pes
+ * @copyright BSD-3-Clause
+ *
+ * This file offers a hash table that many threads can read and update
+ * concurrently. It is made of a power of two number of CHashMap shards, each
+ * one protected by its own readers/writer lock, and every key always lives in
+ * the same shard. So threads working on different shards never wait for each
+ * other, readers of the same shard run in parallel, and a shard that grows
+ * stalls only the threads using that shard.
+ * Values are copied in and out under the lock, since pointers to stored
+ * values would be invalidated by a concurrent growth.
+ * It requires POSIX.1-2001 readers/writer locks: in strict ISO C modes (such
+ * as -std=c89) they are hidden unless _POSIX_C_SOURCE is defined to 200112L
+ * (or _XOPEN_SOURCE to 600) for the whole translation unit, so pass
+ * -D_POSIX_C_SOURCE=200112L to the compiler. Memory errors are reported
+ * through the cvector error callback, see cvector_set_callback()
+ */
+
+#ifndef CSHARDMAP_H_
+#define CSHARDMAP_H_
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "chashmap.h"
+
+/* pthread_rwlock_t and posix_memalign are declared only if the feature
+   macro is set before the first system header, which a header cannot do */
+#if !defined(_POSIX_READER_WRITER_LOCKS) || (_POSIX_READER_WRITER_LOCKS <= 0)
+#error "cshardmap.h requires POSIX readers/writer locks"
+#endif
+#if defined(__STRICT_ANSI__) \
+    && (!defined(_POSIX_C_SOURCE) || (_POSIX_C_SOURCE < 200112L))
+#error "cshardmap.h requires -D_POSIX_C_SOURCE=200112L in strict ISO C modes"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def CSHARDMAP_CACHE_LINE
+ * The size of a cache line. Shards are padded to this size, and the array of
+ * shards is aligned to it, so that the locks of different shards never share
+ * a cache line. It must be a power of two multiple of sizeof(void*)
+ */
+#ifndef CSHARDMAP_CACHE_LINE
+#define CSHARDMAP_CACHE_LINE 64U
+#endif
+
+/**
+ * @def CSHARDMAP_MAX_SHARDS
+ * The maximum number of shards of a map
+ */
+#define CSHARDMAP_MAX_SHARDS 256U
+
+typedef struct {
+    pthread_rwlock_t lock;
+    chashmap_t map;
+} vnut_shard_t;
+
+typedef union {
+    vnut_shard_t s;
+    cv_uchar pad[((sizeof(vnut_shard_t) + CSHARDMAP_CACHE_LINE - 1U)
+                  / CSHARDMAP_CACHE_LINE) * CSHARDMAP_CACHE_LINE];
+} cshardmap_shard_t;
+
+typedef struct {
+    cshardmap_shard_t* shards;
+    cv_ui mask;
+    cv_ui vs;
+    chashmap_hash_t hash;
+} cshardmap_t;
+
+/* the shard comes from the middle bits of the mixed hash: the shard itself
+   takes the group from the low ones and the H2 from the top ones */
+static vnut_shard_t* vnut_shm_shard(const cshardmap_t* map, const void* key) {
+    const cv_ui h = vnut_hm_mix((*map->hash)(key));
+    return &map->shards[(h >> (sizeof(cv_ui) * 4U)) & map->mask].s;
+}
+
+/**
+ * @brief Initialize a concurrent hash table
+ * @param[in] map A pointer to the table to initialize
+ * @param[in] shards The number of shards. It must be a power of two not
+ *            greater than #CSHARDMAP_MAX_SHARDS. A few times the number of
+ *            threads using the table is usually a good value
+ * @param[in] key_size The size of the keys, see chashmap_init()
+ * @param[in] value_size The size of the values. Pass zero to obtain a set
+ * @param[in] num_elems The number of entries the \b whole table must hold
+ *            without growing, or #CVECTOR_DEFAULT_LEN
+ * @param[in] hash The hash function of keys
+ * @note When this function fails, or \a shards is not valid, the error
+ *       callback is called and map->shards is set to NULL
+ * @warning This function and cshardmap_destroy() are not thread-safe
+ */
+static void cshardmap_init(cshardmap_t* map,
+                           cv_ui shards,
+                           cv_ui key_size,
+                           cv_ui value_size,
+                           cv_ui num_elems,
+                           chashmap_hash_t hash)
+{
+    void* p = NULL;
+
+    /* the shard is picked by masking the hash, see vnut_shm_shard() */
+    if ((shards == 0U) || (shards > CSHARDMAP_MAX_SHARDS)
+        || ((shards & (shards - 1U)) != 0U)
+        || (posix_memalign(&p, CSHARDMAP_CACHE_LINE,
+                           shards * sizeof(cshardmap_shard_t)) != 0))
+    {
+        p = NULL;
+    }
+    map->shards = (cshardmap_shard_t*)p;
+    map->mask = shards - 1U;
+    map->vs = value_size;
+    map->hash = hash;
+
+    if (map->shards != NULL) {
+        cv_ui i;
+        for (i = 0U; i < shards; i++) {
+            vnut_shard_t* const s = &map->shards[i].s;
+            chashmap_init(&s->map, key_size, value_size, num_elems / shards,
+                          hash);
+            if ((s->map.ctrl.p == NULL)
+                || (pthread_rwlock_init(&s->lock, NULL) != 0))
+            {
+                if (s->map.ctrl.p != NULL) {
+                    chashmap_destroy(&s->map);
+                }
+                while (i-- > 0U) {
+                    (void)pthread_rwlock_destroy(&map->shards[i].s.lock);
+                    chashmap_destroy(&map->shards[i].s.map);
+                }
+                free(map->shards);
+                map->shards = NULL;
+                break;
+            }
+        }
+    }
+    else {
+        if (cvector_error_callback != NULL) {
+            (*cvector_error_callback)(shards);
+        }
+    }
+}
+
+/**
+ * @brief Destroy a concurrent hash table, deallocating its entries
+ * @param[in] map A pointer to the table to destroy
+ */
+static void cshardmap_destroy(cshardmap_t* map) {
+    cv_ui i;
+    for (i = 0U; i <= map->mask; i++) {
+        (void)pthread_rwlock_destroy(&map->shards[i].s.lock);
+        chashmap_destroy(&map->shards[i].s.map);
+    }
+    free(map->shards);
+    map->shards = NULL;
+}
+
+/**
+ * @brief Search a key and copy its value
+ * @param[in] map A pointer to the table
+ * @param[in] key A pointer to the key to search
+ * @param[out] value Where the value is copied if \a key is present. Can be
+ *             NULL to only test the presence of \a key
+ * @return Non-zero if \a key is present, zero otherwise
+ * @note Only the shard of \a key is locked, in shared mode
+ */
+static int cshardmap_find(cshardmap_t* map, const void* key, void* value) {
+    vnut_shard_t* const s = vnut_shm_shard(map, key);
+    const void* p;
+
+    (void)pthread_rwlock_rdlock(&s->lock);
+    p = chashmap_find(&s->map, key);
+    if ((p != NULL) && (value != NULL) && (map->vs > 0U)) {
+        memcpy(value, p, map->vs);
+    }
+    (void)pthread_rwlock_unlock(&s->lock);
+
+    return (p != NULL) ? 1 : 0;
+}
+
+/**
+ * @brief Insert an entry, or replace the value of an existing one
+ * @param[in] map A pointer to the table
+ * @param[in] key A pointer to the key of the entry
+ * @param[in] value A pointer to the value of the entry. Can be NULL, see
+ *            chashmap_insert()
+ * @return Non-zero on success, zero if the shard cannot grow. In the latter
+ *         case the error callback is called
+ * @note Only the shard of \a key is locked, in exclusive mode. If the shard
+ *       must grow, only the threads using this shard wait for it
+ */
+static int cshardmap_insert(cshardmap_t* map,
+                            const void* key,
+                            const void* value)
+{
+    vnut_shard_t* const s = vnut_shm_shard(map, key);
+    const void* p;
+
+    (void)pthread_rwlock_wrlock(&s->lock);
+    p = chashmap_insert(&s->map, key, value);
+    (void)pthread_rwlock_unlock(&s->lock);
+
+    return (p != NULL) ? 1 : 0;
+}
+
+/**
+ * @brief Remove the entry with given key
+ * @param[in] map A pointer to the table
+ * @param[in] key A pointer to the key of the entry to remove
+ * @return Non-zero if the entry was present and has been removed, zero
+ *         otherwise
+ */
+static int cshardmap_erase(cshardmap_t* map, const void* key) {
+    vnut_shard_t* const s = vnut_shm_shard(map, key);
+    int found;
+
+    (void)pthread_rwlock_wrlock(&s->lock);
+    found = chashmap_erase(&s->map, key);
+    (void)pthread_rwlock_unlock(&s->lock);
+
+    return found;
+}
+
+/**
+ * @brief Return the number of entries of the table
+ * @param[in] map A pointer to the table
+ * @return The number of entries
+ * @note Shards are locked one at a time, so with concurrent updates the
+ *       returned value is only an approximation
+ */
+static cv_ui cshardmap_size(cshardmap_t* map) {
+    cv_ui i, size = 0U;
+    for (i = 0U; i <= map->mask; i++) {
+        vnut_shard_t* const s = &map->shards[i].s;
+        (void)pthread_rwlock_rdlock(&s->lock);
+        size += chashmap_size(&s->map);
+        (void)pthread_rwlock_unlock(&s->lock);
+    }
+    return size;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
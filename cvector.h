@@ -52,6 +52,51 @@ typedef uint8_t cv_uchar;
 #include <stdio.h>
 #endif
 
+#ifdef DOXYGEN_ONLY
+/**
+ * @def CVECTOR_ARENA
+ * If this macro is defined \b before including cvector.h, carena.h is
+ * included and vectors can take their memory from an arena, see
+ * cvector_init_arena(). Otherwise cvector.h needs no other file
+ */
+#define CVECTOR_ARENA
+#endif
+
+#if defined(CVECTOR_ARENA) && !defined(CVECTOR_NO_DYNAMIC_MEMORY)
+#include "carena.h"
+#endif
+
+#ifdef DOXYGEN_ONLY
+/**
+ * @def CVECTOR_PARALLEL_COPY
+ * If this macro is defined \b before including cvector.h, the copies of huge
+ * buffers done by cvector_clone(), cvector_insert_n(), cvector_erase() and by
+ * reallocations are split across threads, and copies bigger than
+ * #CVECTOR_NT_THRESHOLD use non-temporal stores, so that they do not evict
+ * the whole cache. It requires POSIX threads. See
+ * cvector_set_parallel_copy()
+ * @note Above the threshold, reallocations are done by malloc, copy and free
+ *       instead of realloc
+ */
+#define CVECTOR_PARALLEL_COPY
+
+/**
+ * @def CVECTOR_NO_SIMD
+ * Define this macro \b before including cvector.h to never use SSE2
+ * instructions (used to fill and copy buffers), even when they are available
+ */
+#define CVECTOR_NO_SIMD
+#endif
+
+#if !defined(CVECTOR_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define CVECTOR_SSE2
+#endif
+
+#ifdef CVECTOR_PARALLEL_COPY
+#include <pthread.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -152,6 +197,43 @@ extern "C" {
  */
 #define CVECTOR_BACK(pv, t)    CVECTOR_ELEM((pv), (pv)->n - 1U, t)
 
+/**
+ * @def CVECTOR_FOREACH
+ * This macro expands to a \a for statement visiting all the elements of pv,
+ * in order, through a pointer of type \a t. Being a plain loop, its body can
+ * be inlined and vectorized by the compiler
+ * @param[in] pv A pointer to the vector to work with
+ * @param[in] t The type of the elements
+ * @param[in] ptr A variable of type <a>t*</a>, declared by the caller, that
+ *                points to the current element
+ * @code{.c}
+ * int* p;
+ * long sum = 0;
+ * CVECTOR_FOREACH(&v, int, p) {
+ *     sum += *p;
+ * }
+ * @endcode
+ * @warning The vector must not grow nor shrink inside the loop
+ */
+#define CVECTOR_FOREACH(pv, t, ptr) \
+    for ((ptr) = (t*)(void*)(pv)->p; \
+         (ptr) < ((t*)(void*)(pv)->p + (pv)->n); \
+         (ptr)++)
+
+/**
+ * @def CVECTOR_PREFETCH
+ * This macro hints the processor to load in cache the memory pointed by \a p.
+ * It expands to nothing on compilers not offering a prefetch builtin
+ * @param[in] p The address to prefetch. It is never dereferenced, but it
+ *              must point inside a buffer, since even computing an address
+ *              past its end is undefined behaviour
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define CVECTOR_PREFETCH(p)    __builtin_prefetch(p)
+#else
+#define CVECTOR_PREFETCH(p)    ((void)0)
+#endif
+
 
 typedef struct {
     cv_uchar*  p;
@@ -161,6 +243,7 @@ typedef struct {
     cv_ui  t;
     cv_ui  c;
     cv_ui  d;
+    struct vnut_arena_t* a;
 } cvector_t;
 
 /**
@@ -176,6 +259,14 @@ typedef struct {
  */
 typedef void (*cvector_error_callback_t)(cv_ui failed_len);
 
+/**
+ * @typedef cvector_cmp_t
+ * This is the comparison function signature, the same used by \a qsort.
+ * It must return a negative value, zero or a positive value if the first
+ * element is respectively less than, equal to or greater than the second one
+ */
+typedef int (*cvector_cmp_t)(const void*, const void*);
+
 static void cvector_default_error_callback(cv_ui failed_len)
 {
 #ifndef CVECTOR_NO_DYNAMIC_MEMORY
@@ -215,6 +306,181 @@ static void cvector_set_default_callback(void) {
     cvector_error_callback = &cvector_default_error_callback;
 }
 
+#ifdef CVECTOR_PARALLEL_COPY
+
+/**
+ * @def CVECTOR_PARALLEL_COPY_THRESHOLD
+ * The default size in \b bytes from which copies are split across threads,
+ * see cvector_set_parallel_copy()
+ */
+#ifndef CVECTOR_PARALLEL_COPY_THRESHOLD
+#define CVECTOR_PARALLEL_COPY_THRESHOLD (64U * 1024U * 1024U)
+#endif
+
+/**
+ * @def CVECTOR_PARALLEL_COPY_THREADS
+ * The default number of threads copying a buffer, including the calling one
+ */
+#ifndef CVECTOR_PARALLEL_COPY_THREADS
+#define CVECTOR_PARALLEL_COPY_THREADS 4U
+#endif
+
+/**
+ * @def CVECTOR_PARALLEL_COPY_MAX_THREADS
+ * The maximum number of threads copying a buffer
+ */
+#define CVECTOR_PARALLEL_COPY_MAX_THREADS 64U
+
+/**
+ * @def CVECTOR_NT_THRESHOLD
+ * The size in \b bytes from which copies use non-temporal stores. It should
+ * be greater than the last level cache
+ */
+#ifndef CVECTOR_NT_THRESHOLD
+#define CVECTOR_NT_THRESHOLD (32U * 1024U * 1024U)
+#endif
+
+static cv_ui vnut_copy_threshold = CVECTOR_PARALLEL_COPY_THRESHOLD;
+static unsigned int vnut_copy_threads = CVECTOR_PARALLEL_COPY_THREADS;
+
+/**
+ * @brief Configure the parallel copy of huge buffers
+ * @param[in] threshold The size in \b bytes from which copies are split
+ *            across threads
+ * @param[in] threads The number of threads copying a buffer, including the
+ *            calling one. Pass 1 to disable parallel copies. It is limited to
+ *            #CVECTOR_PARALLEL_COPY_MAX_THREADS
+ * @note Threads are started by every copy above the threshold, so the
+ *       threshold must be large enough to amortize their creation
+ * @warning This function is not thread-safe
+ */
+static void cvector_set_parallel_copy(cv_ui threshold, unsigned int threads) {
+    vnut_copy_threshold = threshold;
+    vnut_copy_threads = (threads > CVECTOR_PARALLEL_COPY_MAX_THREADS)
+                        ? CVECTOR_PARALLEL_COPY_MAX_THREADS : threads;
+    if (vnut_copy_threads == 0U) {
+        vnut_copy_threads = 1U;
+    }
+}
+
+typedef struct {
+    cv_uchar* dst;
+    const cv_uchar* src;
+    cv_ui len;
+    int nt;
+} vnut_copy_part_t;
+
+static void* vnut_copy_part(void* arg) {
+    const vnut_copy_part_t* const c = (const vnut_copy_part_t*)arg;
+    cv_uchar* dst = c->dst;
+    const cv_uchar* src = c->src;
+    cv_ui len = c->len;
+
+#ifdef CVECTOR_SSE2
+    if ((c->nt != 0) && (len >= 128U)) {
+        const cv_ui head = (cv_ui)((16U - ((size_t)dst & 15U)) & 15U);
+
+        memcpy(dst, src, head);
+        dst += head;
+        src += head;
+        len -= head;
+
+        while (len >= 64U) {
+            const __m128i a = _mm_loadu_si128((const __m128i*)src);
+            const __m128i b = _mm_loadu_si128((const __m128i*)(src + 16));
+            const __m128i e = _mm_loadu_si128((const __m128i*)(src + 32));
+            const __m128i f = _mm_loadu_si128((const __m128i*)(src + 48));
+            _mm_stream_si128((__m128i*)dst, a);
+            _mm_stream_si128((__m128i*)(dst + 16), b);
+            _mm_stream_si128((__m128i*)(dst + 32), e);
+            _mm_stream_si128((__m128i*)(dst + 48), f);
+            dst += 64;
+            src += 64;
+            len -= 64U;
+        }
+
+        _mm_sfence();
+    }
+#endif
+
+    memcpy(dst, src, len);
+
+    return NULL;
+}
+
+#endif
+
+static void vnut_copy(void* dst, const void* src, cv_ui len) {
+#ifdef CVECTOR_PARALLEL_COPY
+    vnut_copy_part_t parts[CVECTOR_PARALLEL_COPY_MAX_THREADS];
+    pthread_t threads[CVECTOR_PARALLEL_COPY_MAX_THREADS];
+    int started[CVECTOR_PARALLEL_COPY_MAX_THREADS];
+    const cv_ui count = (len >= vnut_copy_threshold) ? vnut_copy_threads : 1U;
+    const cv_ui chunk = (((len + count - 1U) / count) + 63U) & ~(cv_ui)63U;
+    cv_ui i, done = 0U;
+
+    for (i = 0U; (i < count) && (done < len); i++) {
+        parts[i].dst = (cv_uchar*)dst + done;
+        parts[i].src = (const cv_uchar*)src + done;
+        parts[i].len = ((len - done) < chunk) ? (len - done) : chunk;
+        parts[i].nt = (len >= CVECTOR_NT_THRESHOLD) ? 1 : 0;
+        done += parts[i].len;
+        started[i] = (i > 0U)
+                     && (pthread_create(&threads[i], NULL, &vnut_copy_part,
+                                        &parts[i]) == 0);
+    }
+
+    if (i > 0U) {
+        (void)vnut_copy_part(&parts[0]);
+    }
+
+    while (i-- > 1U) {
+        if (started[i] != 0) {
+            (void)pthread_join(threads[i], NULL);
+        }
+        else {
+            (void)vnut_copy_part(&parts[i]);
+        }
+    }
+#else
+    memcpy(dst, src, len);
+#endif
+}
+
+static void vnut_move(void* dst, const void* src, cv_ui len) {
+#ifdef CVECTOR_PARALLEL_COPY
+    cv_uchar* const d = (cv_uchar*)dst;
+    const cv_uchar* const s = (const cv_uchar*)src;
+    const cv_ui dist = (d > s) ? (cv_ui)(d - s) : (cv_ui)(s - d);
+
+    if (dist >= len) {
+        vnut_copy(d, s, len);
+    }
+    else if ((dist == 0U) || (dist < vnut_copy_threshold)) {
+        memmove(d, s, len);
+    }
+    else if (d < s) {
+        /* blocks of dist bytes never overlap their destination, and each
+         * one overwrites only the source of the blocks already moved */
+        cv_ui done;
+        for (done = 0U; done < len; done += dist) {
+            vnut_copy(d + done, s + done,
+                      ((len - done) < dist) ? (len - done) : dist);
+        }
+    }
+    else {
+        cv_ui left = len;
+        while (left > 0U) {
+            const cv_ui step = (left < dist) ? left : dist;
+            left -= step;
+            vnut_copy(d + left, s + left, step);
+        }
+    }
+#else
+    memmove(dst, src, len);
+#endif
+}
+
 /**
  * @brief Initialize a vector with passed memory space. No dynamic memory is
  *        required. This is typically called in embedded environment
@@ -280,6 +546,7 @@ static void cvector_init_ext(cvector_t* pv,
         pv->m = reserved;
         pv->t = type_size;
         pv->d = ((cv_ui)dynamic & 1U) | 2U;
+        pv->a = NULL;
     }
     else {
         pv->p = NULL;
@@ -290,11 +557,13 @@ static void cvector_init_ext(cvector_t* pv,
 }
 
 static cv_ui vnut_init(cvector_t* pv,
+                       struct vnut_arena_t* arena,
                        cv_ui type_size,
                        cv_ui num_elems,
                        int dynamic)
 {
 #ifdef CVECTOR_NO_DYNAMIC_MEMORY
+    (void)arena;
     (void)num_elems;
     (void)dynamic;
     pv->p = NULL;
@@ -325,13 +594,20 @@ static cv_ui vnut_init(cvector_t* pv,
             }
         }
 
+#ifdef CVECTOR_ARENA
+        pv->p = (cv_uchar*)((arena != NULL)
+                            ? carena_alloc(arena, num_elems * type_size)
+                            : malloc(num_elems * type_size));
+#else
         pv->p = (cv_uchar*)malloc(num_elems * type_size);
+#endif
         if (pv->p != NULL) {
             pv->f = pv->p;
             pv->n = 0U;
             pv->m = num_elems;
             pv->t = type_size;
-            pv->d = (cv_ui)dynamic & 1U;
+            pv->d = ((cv_ui)dynamic & 1U) | ((arena != NULL) ? 4U : 0U);
+            pv->a = arena;
         }
         else {
             p_error = &num_elems;
@@ -383,11 +659,41 @@ static void cvector_init(cvector_t* pv,
                          cv_ui num_elems,
                          int dynamic)
 {
-    const cv_ui init_err = vnut_init(pv, type_size, num_elems, dynamic);
+    const cv_ui init_err = vnut_init(pv, NULL, type_size, num_elems, dynamic);
+    if ((pv->p == NULL) && (cvector_error_callback != NULL)) {
+        (*cvector_error_callback)(init_err);
+    }
+}
+
+#if defined(CVECTOR_ARENA) && !defined(CVECTOR_NO_DYNAMIC_MEMORY)
+/**
+ * @brief Initialize a vector whose memory is taken from an arena, see
+ *        carena.h. Available if #CVECTOR_ARENA is defined
+ * @param[in] pv A pointer to the vector to initialize
+ * @param[in] arena The arena providing the memory. It must outlive the vector
+ * @param[in] type_size The size of the type of elements (ex.: sizeof(int))
+ * @param[in] num_elems The number of elements to be allocated, see
+ *            cvector_init()
+ * @param[in] dynamic See cvector_init()
+ * @note Growing the vector is a pointer bump as long as its buffer is the
+ *       last allocation of the arena, a copy otherwise. The buffer is never
+ *       freed: cvector_destroy() only frees the elements if #CVECTOR_FREE_PTR
+ *       was passed, and the memory is reclaimed by carena_reset()
+ * @note When this function fails, the error callaback is called and the
+ *       pointer pv->p is set to NULL
+ */
+static void cvector_init_arena(cvector_t* pv,
+                               carena_t* arena,
+                               cv_ui type_size,
+                               cv_ui num_elems,
+                               int dynamic)
+{
+    const cv_ui init_err = vnut_init(pv, arena, type_size, num_elems, dynamic);
     if ((pv->p == NULL) && (cvector_error_callback != NULL)) {
         (*cvector_error_callback)(init_err);
     }
 }
+#endif
 
 /**
  * @brief Initialize a new vector, using dynamic memory
@@ -412,7 +718,7 @@ static cvector_t* cvector_new(cv_ui type_size, cv_ui num_elems, int dynamic)
 #else
     cvector_t* pv = (cvector_t*)malloc(sizeof(cvector_t));
     if (pv != NULL) {
-        (void)vnut_init(pv, type_size, num_elems, dynamic);
+        (void)vnut_init(pv, NULL, type_size, num_elems, dynamic);
         if (pv->p == NULL) {
             free(pv);
             pv = NULL;
@@ -448,10 +754,12 @@ static cvector_t* cvector_clone(cvector_t* clone, const cvector_t* pv) {
         const cv_ui t = pv->t;
 
         *other = *pv;
+        other->d &= 1U;
+        other->a = NULL;
 
         other->p = (cv_uchar*)malloc(pv->m * t);
         if (other->p != NULL) {
-            memcpy(other->p, pv->p, pv->n * t);
+            vnut_copy(other->p, pv->p, pv->n * t);
             other->f = other->p + (pv->n * t);
         }
         else {
@@ -477,7 +785,7 @@ static cvector_t* cvector_clone(cvector_t* clone, const cvector_t* pv) {
         other->f = other->p + (pv->n * pv->t);
         other->m = m;
 
-        memcpy(other->p, pv->p, pv->n * pv->t);
+        vnut_copy(other->p, pv->p, pv->n * pv->t);
     }
 
 #endif
@@ -512,14 +820,14 @@ static void cvector_clear(cvector_t* pv) {
  * @note This call frees all memory occupied by elements.
  *       After destroy, the only allowed operations are init and delete.
  *       Calling destroy consecutively on the same vector is useless but allowed
- * @note If a vector was initialized by cvector_init_ext(), no memory will be
- *       freed
+ * @note If a vector was initialized by cvector_init_ext() or
+ *       cvector_init_arena(), no memory will be freed
  * @sa cvector_delete()
  */
 static void cvector_destroy(cvector_t* pv) {
     cvector_clear(pv);
 #ifndef CVECTOR_NO_DYNAMIC_MEMORY
-    if ((pv->d & 2U) == 0U) {
+    if ((pv->d & 6U) == 0U) {
         free(pv->p);
     }
 #endif
@@ -554,6 +862,35 @@ static void cvector_delete(cvector_t** pv) {
     }
 }
 
+#ifndef CVECTOR_NO_DYNAMIC_MEMORY
+static void* vnut_realloc(cvector_t* pv, cv_ui size) {
+    void* p;
+#ifdef CVECTOR_PARALLEL_COPY
+    const cv_ui used = pv->n * pv->t;
+#endif
+#ifdef CVECTOR_ARENA
+    if ((pv->d & 4U) != 0U) {
+        p = carena_realloc(pv->a, pv->p, pv->m * pv->t, size);
+    }
+    else
+#endif
+#ifdef CVECTOR_PARALLEL_COPY
+    if ((used >= vnut_copy_threshold) && (vnut_copy_threads > 1U)) {
+        p = malloc(size);
+        if (p != NULL) {
+            vnut_copy(p, pv->p, used);
+            free(pv->p);
+        }
+    }
+    else
+#endif
+    {
+        p = realloc(pv->p, size);
+    }
+    return p;
+}
+#endif
+
 static int vnut_reserve(cvector_t* pv, cv_ui new_size) {
 #ifdef CVECTOR_NO_DYNAMIC_MEMORY
     (void)pv;
@@ -583,10 +920,10 @@ static int vnut_reserve(cvector_t* pv, cv_ui new_size) {
             trying = new_size;
         }
 
-        p = realloc(pv->p, trying * ts);
+        p = vnut_realloc(pv, trying * ts);
         if (p == NULL && trying > new_size) {
             trying = new_size;
-            p = realloc(pv->p, trying * ts);
+            p = vnut_realloc(pv, trying * ts);
         }
 
         ok = p != NULL;
@@ -695,6 +1032,69 @@ static void cvector_set_data(cvector_t* pv, cv_ui idx, const void* elem) {
     memcpy(pv->p + (idx * pv->t), elem, pv->t);
 }
 
+/**
+ * @def CVECTOR_FILL_BLOCK
+ * The size in \b bytes of the block replicated by the fill of elements of
+ * any size: the first element is copied doubling the filled region up to
+ * this size, then the whole block is copied. It should fit in the L1 cache
+ */
+#ifndef CVECTOR_FILL_BLOCK
+#define CVECTOR_FILL_BLOCK 8192U
+#endif
+
+static void vnut_fill(cv_uchar* dest, const void* elem, cv_ui t, cv_ui len) {
+    const cv_uchar* const e = (const cv_uchar*)elem;
+    const cv_ui total = len * t;
+    cv_ui i = 1U;
+
+    while ((i < t) && (e[i] == e[0])) {
+        i++;
+    }
+
+    if (i == t) {
+        memset(dest, e[0], total);
+    }
+#ifdef CVECTOR_SSE2
+    else if ((t <= 16U) && ((16U % t) == 0U)) {
+        cv_uchar pattern[16];
+        __m128i v;
+        cv_ui done;
+
+        for (i = 0U; i < 16U; i += t) {
+            memcpy(pattern + i, e, t);
+        }
+        v = _mm_loadu_si128((const __m128i*)pattern);
+
+        for (done = 0U; (done + 64U) <= total; done += 64U) {
+            _mm_storeu_si128((__m128i*)(dest + done), v);
+            _mm_storeu_si128((__m128i*)(dest + done + 16U), v);
+            _mm_storeu_si128((__m128i*)(dest + done + 32U), v);
+            _mm_storeu_si128((__m128i*)(dest + done + 48U), v);
+        }
+        for (; (done + 16U) <= total; done += 16U) {
+            _mm_storeu_si128((__m128i*)(dest + done), v);
+        }
+        memcpy(dest + done, pattern, total - done);
+    }
+#endif
+    else {
+        cv_ui done = t;
+
+        memcpy(dest, e, t);
+        while ((done < total) && (done < CVECTOR_FILL_BLOCK)) {
+            const cv_ui step = ((total - done) < done) ? (total - done) : done;
+            memcpy(dest + done, dest, step);
+            done += step;
+        }
+        i = done;
+        while (done < total) {
+            const cv_ui step = ((total - done) < i) ? (total - done) : i;
+            memcpy(dest + done, dest, step);
+            done += step;
+        }
+    }
+}
+
 /**
  * @brief Set a subset of elements
  * @param[in] pv A pointer to the vector
@@ -705,6 +1105,10 @@ static void cvector_set_data(cvector_t* pv, cv_ui idx, const void* elem) {
  *                            be replicated \a len times, at pv[idx..idx+len-1].
  *                            If zero, \a len elements will be copied from
  *                            elem[0..len-1] to pv[idx..idx+len-1]
+ * @note Replicated elements are written with memset when all their bytes are
+ *       equal (zero for example), with SIMD stores when their size divides
+ *       16 bytes, and by copying larger and larger already filled blocks
+ *       otherwise
  * @warning This function assumes that requested space is \b already available
  */
 static void cvector_set_elems(cvector_t* pv,
@@ -716,11 +1120,7 @@ static void cvector_set_elems(cvector_t* pv,
     if (len > 0U) {
         const cv_ui t = pv->t;
         if (is_same_element != 0) {
-            cv_uchar* dest = pv->p + (idx * t);
-            cv_ui i;
-            for (i = 0U; i < len; i++, dest += t) {
-                memcpy(dest, elem, t);
-            }
+            vnut_fill(pv->p + (idx * t), elem, t, len);
         }
         else {
             memcpy(pv->p + (idx * t), elem, len * t);
@@ -795,9 +1195,9 @@ static void cvector_insert_n(cvector_t* pv,
             if (ok != 0) {
                 const cv_ui t = pv->t;
                 if (idx < pv->n) {
-                    memmove(pv->p + ((idx + len) * t),
-                            pv->p + (idx * t),
-                            (pv->n - idx) * t);
+                    vnut_move(pv->p + ((idx + len) * t),
+                              pv->p + (idx * t),
+                              (pv->n - idx) * t);
                 }
                 if (elem != NULL) {
                     cvector_set_elems(pv, idx, len, elem, is_same_element);
@@ -829,9 +1229,9 @@ static void cvector_erase(cvector_t* pv, cv_ui idx, cv_ui len) {
         }
 #endif
         if ((idx + len) < pv->n) {
-            memmove(pv->p + (idx * t),
-                    pv->p + (idx + len) * t,
-                    (pv->n - (idx + len)) * t);
+            vnut_move(pv->p + (idx * t),
+                      pv->p + (idx + len) * t,
+                      (pv->n - (idx + len)) * t);
         }
         pv->n -= len;
         pv->f -= (len * t);
@@ -924,11 +1324,11 @@ static void cvector_shrink_to_fit(cvector_t* pv) {
     (void)pv;
 #else
     const cv_ui n = pv->n;
-    if ((n < pv->m) && ((pv->d & 2U) == 0U)) {
+    if ((n < pv->m) && ((pv->d & 6U) == 0U)) {
         const cv_ui total = ((n == 0U) ? 1 : n) * pv->t;
         void* const p = malloc(total);
         if (p != NULL) {
-            memcpy(p, pv->p, total);
+            vnut_copy(p, pv->p, total);
             pv->m = total / pv->t;
             pv->f = (cv_uchar*)p + total;
             free(pv->p);
@@ -938,6 +1338,115 @@ static void cvector_shrink_to_fit(cvector_t* pv) {
 #endif
 }
 
+static cv_ui vnut_eytzinger_fill(cv_uchar* dst,
+                                 const cv_uchar* src,
+                                 cv_ui t,
+                                 cv_ui n,
+                                 cv_ui i,
+                                 cv_ui k)
+{
+    if (k <= n) {
+        i = vnut_eytzinger_fill(dst, src, t, n, i, 2U * k);
+        memcpy(dst + (k * t), src + (i * t), t);
+        i = vnut_eytzinger_fill(dst, src, t, n, i + 1U, (2U * k) + 1U);
+    }
+    return i;
+}
+
+/**
+ * @brief Build a search index with the Eytzinger (BFS) layout from a sorted
+ *        vector
+ * @param[out] dst The vector that will contain the index. It must be already
+ *             initialized with the same type size of \a sorted_src and with
+ *             #CVECTOR_DATA. Its previous content is discarded
+ * @param[in] sorted_src The vector to index, sorted in ascending order
+ * @note The element at index 0 of \a dst is unused, the tree root is at index
+ *       1, and the children of the node at index k are at 2k and 2k+1. So
+ *       \a dst will have one element more than \a sorted_src
+ * @note If \a dst has not enough room and cannot grow, the error callback is
+ *       called as in cvector_resize()
+ * @note The layout puts the first levels of the tree in the same cache lines,
+ *       so a search costs much less cache misses than a binary search on
+ *       \a sorted_src. The index is meant for read-mostly data, it must be
+ *       rebuilt after any change to \a sorted_src
+ * @sa cvector_eytzinger_search()
+ */
+static void cvector_build_eytzinger(cvector_t* dst, const cvector_t* sorted_src)
+{
+    const cv_ui n = sorted_src->n;
+    cvector_clear(dst);
+    cvector_resize(dst, n + 1U, NULL);
+    if (dst->n == (n + 1U)) {
+        memset(dst->p, 0, dst->t);
+        (void)vnut_eytzinger_fill(dst->p, sorted_src->p, dst->t, n, 0U, 1U);
+    }
+}
+
+/**
+ * @brief Search a key in an index built by cvector_build_eytzinger()
+ * @param[in] eytz The index to search
+ * @param[in] key A pointer to the key to search
+ * @param[in] cmp The comparison function, the same used to sort the original
+ *            vector. It is called with an element of \a eytz as first
+ *            parameter and \a key as second one
+ * @return The index, in the \b original sorted vector, of the first element
+ *         not less than \a key (like C++ std::lower_bound). If all elements
+ *         are less than \a key, the size of the original vector is returned.
+ *         An empty index (or one that could not be built) gives 0
+ * @note The result of \a cmp selects the child without a branch, and the
+ *       nodes four levels below the current one are prefetched, so memory
+ *       latency is overlapped with the comparisons. Then the rank is
+ *       computed in O(1) from the position of the found node in the tree
+ */
+static cv_ui cvector_eytzinger_search(const cvector_t* eytz,
+                                      const void* key,
+                                      cvector_cmp_t cmp)
+{
+    cv_ui rank = 0U;
+
+    /* an index holds at least the unused slot 0, unless building it failed */
+    if (eytz->n >= 2U) {
+        const cv_uchar* const p = eytz->p;
+        const cv_ui t = eytz->t;
+        const cv_ui n = eytz->n - 1U;
+        const cv_ui ahead = n / 16U;
+        cv_ui levels = 0U;
+        cv_ui depth;
+        cv_ui k = 1U;
+
+        while (k <= n) {
+            CVECTOR_PREFETCH(p + (((k <= ahead) ? (k * 16U) : 0U) * t));
+            k = (2U * k) + (cv_ui)((*cmp)(p + (k * t), key) < 0);
+            levels++;
+        }
+
+        depth = levels;
+        while ((k & 1U) != 0U) {
+            k >>= 1U;
+            depth--;
+        }
+        k >>= 1U;
+        depth--;
+
+        rank = n;
+        if (k > 0U) {
+            /* the in-order position of k in the perfect tree of height h,
+               less the leaves missing from its last level before that
+               position. The descent stopped one level below the last one,
+               or on it */
+            const cv_ui h = (((cv_ui)1U << levels) <= n) ? levels
+                                                          : (levels - 1U);
+            const cv_ui leaves = n + 1U - ((cv_ui)1U << h);
+            const cv_ui r = ((((2U * k) + 1U) << (h - depth))
+                             - ((cv_ui)2U << h)) - 1U;
+            const cv_ui before = (r + 1U) / 2U;
+            rank = (before > leaves) ? (r - (before - leaves)) : r;
+        }
+    }
+
+    return rank;
+}
+
 #ifdef __cplusplus
 }
 #endif
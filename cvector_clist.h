@@ -0,0 +1,80 @@
+/**
+ * @file      cvector_clist.h
+ * @version   1.0
+ * @brief     Bulk conversions between CVector and CList for C89 language
+ * @date      Sat Oct 17 01:48:38 2026
+ * @author    Michele Pes
+ * @copyright BSD-3-Clause
+ *
+ * This file moves values between the two containers in bulk, for programs
+ * switching representation between phases: a vector becomes list nodes
+ * allocated in one block and linked in a single pass, and a list becomes a
+ * vector reserved once and filled in a single traversal.
+ * Values are copied, never shared: the containers keep their own
+ * initialization flags, so at most one of them should free the pointers
+ * they store (see #CVECTOR_FREE_PTR and #CLIST_PAYLOAD_FREE)
+ */
+
+#ifndef CVECTOR_CLIST_H_
+#define CVECTOR_CLIST_H_
+
+#include "cvector.h"
+#include "clist.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Append all the elements of a vector at the end of a list
+ * @param[in] list An initialized list whose type_size is the one of \a pv
+ * @param[in] pv The vector to read
+ * @retval EXIT_SUCCESS If all the elements are added
+ * @retval EXIT_FAILURE If \a list is NULL, the type sizes differ or not
+ *         enough memory. In this case the list is left untouched
+ * @note See clist_append_array() for the allocation of the nodes
+ */
+static int clist_from_cvector(clist_t* list, const cvector_t* pv) {
+    return ((list != NULL) && (list->type_size == pv->t))
+           ? clist_append_array(list, pv->p, pv->n) : EXIT_FAILURE;
+}
+
+/**
+ * @brief Append all the values of a list at the end of a vector
+ * @param[in] pv An initialized vector whose type size is the one of \a list
+ * @param[in] list The list to read. Can be NULL
+ * @note The vector grows once, then the values are copied in one traversal,
+ *       prefetching #CLIST_PREFETCH_DISTANCE nodes ahead. If the vector
+ *       cannot grow, the error callback is called and nothing is copied
+ * @note If \a list is NULL or the type sizes differ, the function does
+ *       nothing
+ */
+static void cvector_from_clist(cvector_t* pv, const clist_t* list) {
+    if ((list != NULL) && (list->type_size == pv->t) && (list->size > 0U)) {
+        const cv_ui t = pv->t;
+        const cv_ui n = pv->n + list->size;
+
+        cvector_reserve(pv, n);
+        if (pv->m >= n) {
+            const clist_node_t* node = list->head;
+            clist_node_t* ahead = vnut_cl_prefetch_from(list->head, 0);
+            cv_uchar* dst = pv->f;
+
+            while (node != NULL) {
+                memcpy(dst, node + 1, t);
+                dst += t;
+                node = node->next;
+                ahead = vnut_cl_prefetch_next(ahead, 0);
+            }
+
+            pv->f = dst;
+            pv->n = n;
+        }
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,553 @@
+/**
+ * @file      cvector_par.h
+ * @version   1.0
+ * @brief     Parallel algorithms on CVector for C89 language
+ * @date      Sat Oct 17 01:25:09 2026
+ * @author    Michele Pes
+ * @copyright BSD-3-Clause
+ *
+ * This file offers parallel versions of the usual loops on vectors: for each,
+ * transform and reduce. The vector buffer is split in chunks whose size in
+ * bytes is a multiple of the cache line, so that no two workers write the
+ * same cache line, and chunks are executed by a CPool (see cpool.h).
+ * It also offers prefix sums (scans) of integer vectors, computed with SIMD
+ * instructions inside a chunk and with two passes over the chunks.
+ * All functions accept a NULL pool, in that case they run on the calling
+ * thread, as they do for vectors too small to be worth splitting.
+ * It requires POSIX threads and the GCC/Clang atomic builtins
+ */
+
+#ifndef CVECTOR_PAR_H_
+#define CVECTOR_PAR_H_
+
+#include <limits.h>
+#include "cvector.h"
+#include "cpool.h"
+
+#if !defined(CVECTOR_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define CVECTOR_PAR_SSE2
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def CVECTOR_PAR_GRAIN
+ * The minimum size in \b bytes of the chunks executed by a worker
+ */
+#ifndef CVECTOR_PAR_GRAIN
+#define CVECTOR_PAR_GRAIN 65536U
+#endif
+
+/**
+ * @def CVECTOR_PAR_CHUNKS_PER_WORKER
+ * The number of chunks each worker gets on average. More chunks balance
+ * better the load when elements have different costs
+ */
+#ifndef CVECTOR_PAR_CHUNKS_PER_WORKER
+#define CVECTOR_PAR_CHUNKS_PER_WORKER 4U
+#endif
+
+/**
+ * @typedef cvector_par_fn_t
+ * Prototype of the function passed to cvector_par_for_each()
+ */
+typedef void (*cvector_par_fn_t)(void* elem, void* ctx);
+
+/**
+ * @typedef cvector_par_transform_fn_t
+ * Prototype of the function passed to cvector_par_transform(). It writes in
+ * \a out the transformation of \a in
+ */
+typedef void (*cvector_par_transform_fn_t)(void* out,
+                                           const void* in,
+                                           void* ctx);
+
+/**
+ * @typedef cvector_par_reduce_fn_t
+ * Prototype of the functions passed to cvector_par_reduce(). It combines
+ * \a value into the accumulator \a acc
+ */
+typedef void (*cvector_par_reduce_fn_t)(void* acc,
+                                        const void* value,
+                                        void* ctx);
+
+typedef struct {
+    cv_uchar* out;
+    const cv_uchar* in;
+    cv_ui len;
+    cv_ui ts_out;
+    cv_ui ts_in;
+    void* acc;
+    cvector_par_fn_t fn;
+    cvector_par_transform_fn_t tfn;
+    cvector_par_reduce_fn_t rfn;
+    void* ctx;
+} vnut_par_chunk_t;
+
+static cv_ui vnut_par_chunk_len(const cpool_t* pool, cv_ui n, cv_ui t) {
+    const cv_ui parts = (cv_ui)cpool_size(pool)
+                        * CVECTOR_PAR_CHUNKS_PER_WORKER;
+    cv_ui unit = CPOOL_CACHE_LINE;
+    cv_ui len = (n + parts - 1U) / parts;
+    cv_ui odd = t;
+
+    while (((odd % 2U) == 0U) && (unit > 1U)) {
+        odd /= 2U;
+        unit /= 2U;
+    }
+
+    if (len < (CVECTOR_PAR_GRAIN / t)) {
+        len = CVECTOR_PAR_GRAIN / t;
+    }
+
+    return ((len + unit - 1U) / unit) * unit;
+}
+
+static void vnut_par_for_each(void* arg) {
+    const vnut_par_chunk_t* const c = (const vnut_par_chunk_t*)arg;
+    cv_uchar* p = c->out;
+    cv_ui i;
+    for (i = 0U; i < c->len; i++, p += c->ts_out) {
+        (*c->fn)(p, c->ctx);
+    }
+}
+
+static void vnut_par_transform(void* arg) {
+    const vnut_par_chunk_t* const c = (const vnut_par_chunk_t*)arg;
+    cv_uchar* out = c->out;
+    const cv_uchar* in = c->in;
+    cv_ui i;
+    for (i = 0U; i < c->len; i++, out += c->ts_out, in += c->ts_in) {
+        (*c->tfn)(out, in, c->ctx);
+    }
+}
+
+static void vnut_par_reduce(void* arg) {
+    const vnut_par_chunk_t* const c = (const vnut_par_chunk_t*)arg;
+    const cv_uchar* in = c->in;
+    cv_ui i;
+    for (i = 0U; i < c->len; i++, in += c->ts_in) {
+        (*c->rfn)(c->acc, in, c->ctx);
+    }
+}
+
+static void vnut_par_run(cpool_t* pool, vnut_par_chunk_t* proto, cv_ui n,
+                         cpool_fn_t fn, cv_uchar* accs, cv_ui acc_size)
+{
+    const cv_ui len = (pool != NULL)
+                      ? vnut_par_chunk_len(pool, n, (proto->ts_out > 0U)
+                                                    ? proto->ts_out
+                                                    : proto->ts_in)
+                      : n;
+    const cv_ui count = (len > 0U) ? ((n + len - 1U) / len) : 0U;
+    cpool_task_t* tasks = NULL;
+    vnut_par_chunk_t* chunks = NULL;
+
+    if ((pool != NULL) && (count > 1U)) {
+        tasks = (cpool_task_t*)malloc(count * sizeof(cpool_task_t));
+        chunks = (vnut_par_chunk_t*)malloc(count * sizeof(vnut_par_chunk_t));
+    }
+
+    if ((tasks != NULL) && (chunks != NULL)) {
+        cv_ui i;
+        for (i = 0U; i < count; i++) {
+            const cv_ui begin = i * len;
+            chunks[i] = *proto;
+            chunks[i].len = ((n - begin) < len) ? (n - begin) : len;
+            if (proto->out != NULL) {
+                chunks[i].out += begin * proto->ts_out;
+            }
+            if (proto->in != NULL) {
+                chunks[i].in += begin * proto->ts_in;
+            }
+            if (accs != NULL) {
+                chunks[i].acc = accs + (i * acc_size);
+            }
+            tasks[i].fn = fn;
+            tasks[i].arg = &chunks[i];
+        }
+        cpool_run(pool, tasks, count);
+    }
+    else {
+        proto->len = n;
+        proto->acc = accs;
+        (*fn)(proto);
+    }
+
+    free(chunks);
+    free(tasks);
+}
+
+/**
+ * @brief Call a function on every element of a vector, in parallel
+ * @param[in] pool The pool executing the chunks, or NULL
+ * @param[in] pv A pointer to the vector
+ * @param[in] fn The function to call on every element. It receives a pointer
+ *            to the element and \a ctx. Different elements are processed
+ *            concurrently, in no particular order
+ * @param[in] ctx A pointer passed to every call of \a fn. Can be NULL
+ */
+static void cvector_par_for_each(cpool_t* pool,
+                                 cvector_t* pv,
+                                 cvector_par_fn_t fn,
+                                 void* ctx)
+{
+    vnut_par_chunk_t c;
+    memset(&c, 0, sizeof(c));
+    c.out = pv->p;
+    c.ts_out = pv->t;
+    c.fn = fn;
+    c.ctx = ctx;
+    vnut_par_run(pool, &c, pv->n, &vnut_par_for_each, NULL, 0U);
+}
+
+/**
+ * @brief Write in \a dst the transformation of every element of \a src, in
+ *        parallel
+ * @param[in] pool The pool executing the chunks, or NULL
+ * @param[out] dst A pointer to the destination vector, already initialized.
+ *             Its type size can differ from the one of \a src. It is resized
+ *             to the size of \a src (calling the error callback on failure)
+ * @param[in] src A pointer to the source vector. It can be \a dst itself
+ * @param[in] fn The function writing the transformation of one element
+ * @param[in] ctx A pointer passed to every call of \a fn. Can be NULL
+ */
+static void cvector_par_transform(cpool_t* pool,
+                                  cvector_t* dst,
+                                  const cvector_t* src,
+                                  cvector_par_transform_fn_t fn,
+                                  void* ctx)
+{
+    const cv_ui n = src->n;
+    if (dst != src) {
+        cvector_resize(dst, n, NULL);
+    }
+    if (dst->n == n) {
+        vnut_par_chunk_t c;
+        memset(&c, 0, sizeof(c));
+        c.out = dst->p;
+        c.in = src->p;
+        c.ts_out = dst->t;
+        c.ts_in = src->t;
+        c.tfn = fn;
+        c.ctx = ctx;
+        vnut_par_run(pool, &c, n, &vnut_par_transform, NULL, 0U);
+    }
+}
+
+/**
+ * @brief Reduce all elements of a vector to a single value, in parallel
+ * @param[in] pool The pool executing the chunks, or NULL
+ * @param[in] pv A pointer to the vector
+ * @param[in,out] result On input, the identity value of the reduction
+ *                (ex.: zero for a sum). On output, the result
+ * @param[in] result_size The size of \a result
+ * @param[in] accumulate The function combining one element into a partial
+ *            result. Every chunk starts from a copy of the identity value
+ * @param[in] merge The function combining a partial result into \a result.
+ *            Partial results are merged in the order of their chunks, so the
+ *            result is the same for any number of workers if the reduction is
+ *            associative
+ * @param[in] ctx A pointer passed to every call of \a accumulate and \a merge.
+ *            Can be NULL
+ * @note If the partial results cannot be allocated, the reduction runs on the
+ *       calling thread
+ */
+static void cvector_par_reduce(cpool_t* pool,
+                               const cvector_t* pv,
+                               void* result,
+                               cv_ui result_size,
+                               cvector_par_reduce_fn_t accumulate,
+                               cvector_par_reduce_fn_t merge,
+                               void* ctx)
+{
+    const cv_ui n = pv->n;
+    const cv_ui len = (pool != NULL) ? vnut_par_chunk_len(pool, n, pv->t) : n;
+    const cv_ui count = (len > 0U) ? ((n + len - 1U) / len) : 0U;
+    cv_uchar* accs = NULL;
+    vnut_par_chunk_t c;
+
+    memset(&c, 0, sizeof(c));
+    c.in = pv->p;
+    c.ts_in = pv->t;
+    c.rfn = accumulate;
+    c.ctx = ctx;
+
+    if ((pool != NULL) && (count > 1U)) {
+        accs = (cv_uchar*)malloc(count * result_size);
+    }
+
+    if (accs != NULL) {
+        cv_ui i;
+        for (i = 0U; i < count; i++) {
+            memcpy(accs + (i * result_size), result, result_size);
+        }
+        vnut_par_run(pool, &c, n, &vnut_par_reduce, accs, result_size);
+        for (i = 0U; i < count; i++) {
+            (*merge)(result, accs + (i * result_size), ctx);
+        }
+        free(accs);
+    }
+    else {
+        vnut_par_run(NULL, &c, n, &vnut_par_reduce, (cv_uchar*)result, 0U);
+    }
+}
+
+#if ULONG_MAX > 0xFFFFFFFFUL
+typedef unsigned long vnut_u64;
+#else
+typedef unsigned long long vnut_u64;
+#endif
+
+#define VNUT_SCAN_DEFINE(name, T)                                             \
+static vnut_u64 name(void* out, const void* in, cv_ui n, vnut_u64 carry,     \
+                     int inclusive)                                           \
+{                                                                             \
+    T* const o = (T*)out;                                                     \
+    const T* const x = (const T*)in;                                          \
+    T c = (T)carry;                                                           \
+    cv_ui i;                                                                  \
+    if (inclusive != 0) {                                                     \
+        for (i = 0U; i < n; i++) {                                            \
+            c = (T)(c + x[i]);                                                \
+            o[i] = c;                                                         \
+        }                                                                     \
+    }                                                                         \
+    else {                                                                    \
+        for (i = 0U; i < n; i++) {                                            \
+            const T v = x[i];                                                 \
+            o[i] = c;                                                         \
+            c = (T)(c + v);                                                   \
+        }                                                                     \
+    }                                                                         \
+    return (vnut_u64)c;                                                       \
+}                                                                             \
+                                                                              \
+static vnut_u64 name##_sum(const void* in, cv_ui n) {                         \
+    const T* const x = (const T*)in;                                          \
+    T c = 0U;                                                                 \
+    cv_ui i;                                                                  \
+    for (i = 0U; i < n; i++) {                                                \
+        c = (T)(c + x[i]);                                                    \
+    }                                                                         \
+    return (vnut_u64)c;                                                       \
+}
+
+VNUT_SCAN_DEFINE(vnut_scan_8, unsigned char)
+VNUT_SCAN_DEFINE(vnut_scan_16, unsigned short)
+VNUT_SCAN_DEFINE(vnut_scan_32, unsigned int)
+VNUT_SCAN_DEFINE(vnut_scan_64, vnut_u64)
+
+#ifdef CVECTOR_PAR_SSE2
+static vnut_u64 vnut_scan_32_sse2(void* out, const void* in, cv_ui n,
+                                  vnut_u64 carry, int inclusive)
+{
+    unsigned int* const o = (unsigned int*)out;
+    const unsigned int* const x = (const unsigned int*)in;
+    __m128i c = _mm_set1_epi32((int)(unsigned int)carry);
+    cv_ui i;
+
+    for (i = 0U; (i + 4U) <= n; i += 4U) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(x + i));
+        __m128i sum = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+        sum = _mm_add_epi32(sum, _mm_slli_si128(sum, 8));
+        sum = _mm_add_epi32(sum, c);
+        _mm_storeu_si128((__m128i*)(o + i),
+                         (inclusive != 0) ? sum : _mm_sub_epi32(sum, v));
+        c = _mm_shuffle_epi32(sum, 0xFF);
+    }
+
+    return vnut_scan_32(o + i, x + i, n - i,
+                        (unsigned int)_mm_cvtsi128_si32(c), inclusive);
+}
+
+#if defined(__x86_64__) || defined(_M_X64)
+static vnut_u64 vnut_scan_64_sse2(void* out, const void* in, cv_ui n,
+                                  vnut_u64 carry, int inclusive)
+{
+    vnut_u64* const o = (vnut_u64*)out;
+    const vnut_u64* const x = (const vnut_u64*)in;
+    __m128i c = _mm_loadl_epi64((const __m128i*)&carry);
+    cv_ui i;
+
+    c = _mm_unpacklo_epi64(c, c);
+    for (i = 0U; (i + 2U) <= n; i += 2U) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(x + i));
+        __m128i sum = _mm_add_epi64(v, _mm_slli_si128(v, 8));
+        sum = _mm_add_epi64(sum, c);
+        _mm_storeu_si128((__m128i*)(o + i),
+                         (inclusive != 0) ? sum : _mm_sub_epi64(sum, v));
+        c = _mm_unpackhi_epi64(sum, sum);
+    }
+
+    _mm_storel_epi64((__m128i*)&carry, c);
+    return vnut_scan_64(o + i, x + i, n - i, carry, inclusive);
+}
+#endif
+#endif
+
+typedef vnut_u64 (*vnut_scan_fn_t)(void*, const void*, cv_ui, vnut_u64, int);
+typedef vnut_u64 (*vnut_sum_fn_t)(const void*, cv_ui);
+
+typedef struct {
+    vnut_scan_fn_t scan;
+    vnut_sum_fn_t sum;
+    cv_uchar* out;
+    const cv_uchar* in;
+    cv_ui len;
+    vnut_u64 carry;
+    int inclusive;
+} vnut_scan_chunk_t;
+
+static int vnut_scan_kernel(vnut_scan_chunk_t* c, cv_ui t) {
+    int ok = 1;
+    if (t == 1U) {
+        c->scan = &vnut_scan_8;
+        c->sum = &vnut_scan_8_sum;
+    }
+    else if (t == sizeof(unsigned short)) {
+        c->scan = &vnut_scan_16;
+        c->sum = &vnut_scan_16_sum;
+    }
+    else if (t == sizeof(unsigned int)) {
+#ifdef CVECTOR_PAR_SSE2
+        c->scan = (UINT_MAX == 0xFFFFFFFFU) ? &vnut_scan_32_sse2
+                                            : &vnut_scan_32;
+#else
+        c->scan = &vnut_scan_32;
+#endif
+        c->sum = &vnut_scan_32_sum;
+    }
+    else if (t == sizeof(vnut_u64)) {
+#if defined(CVECTOR_PAR_SSE2) && (defined(__x86_64__) || defined(_M_X64))
+        c->scan = &vnut_scan_64_sse2;
+#else
+        c->scan = &vnut_scan_64;
+#endif
+        c->sum = &vnut_scan_64_sum;
+    }
+    else {
+        ok = 0;
+    }
+    return ok;
+}
+
+static void vnut_scan_sum_task(void* arg) {
+    vnut_scan_chunk_t* const c = (vnut_scan_chunk_t*)arg;
+    c->carry = (*c->sum)(c->in, c->len);
+}
+
+static void vnut_scan_task(void* arg) {
+    vnut_scan_chunk_t* const c = (vnut_scan_chunk_t*)arg;
+    (void)(*c->scan)(c->out, c->in, c->len, c->carry, c->inclusive);
+}
+
+static void vnut_scan(cpool_t* pool,
+                      cvector_t* dst,
+                      const cvector_t* src,
+                      int inclusive)
+{
+    const cv_ui n = src->n;
+    vnut_scan_chunk_t proto;
+
+    if (dst != src) {
+        cvector_resize(dst, n, NULL);
+    }
+
+    proto.out = dst->p;
+    proto.in = src->p;
+    proto.len = n;
+    proto.carry = 0U;
+    proto.inclusive = inclusive;
+
+    if ((dst->n == n) && (vnut_scan_kernel(&proto, src->t) != 0)) {
+        const cv_ui len = (pool != NULL)
+                          ? vnut_par_chunk_len(pool, n, src->t) : n;
+        const cv_ui count = (len > 0U) ? ((n + len - 1U) / len) : 0U;
+        cpool_task_t* tasks = NULL;
+        vnut_scan_chunk_t* chunks = NULL;
+
+        if ((pool != NULL) && (count > 1U)) {
+            tasks = (cpool_task_t*)malloc(count * sizeof(cpool_task_t));
+            chunks = (vnut_scan_chunk_t*)malloc(count
+                                                * sizeof(vnut_scan_chunk_t));
+        }
+
+        if ((tasks != NULL) && (chunks != NULL)) {
+            vnut_u64 carry = 0U;
+            cv_ui i;
+
+            for (i = 0U; i < count; i++) {
+                const cv_ui begin = i * len;
+                chunks[i] = proto;
+                chunks[i].len = ((n - begin) < len) ? (n - begin) : len;
+                chunks[i].out += begin * src->t;
+                chunks[i].in += begin * src->t;
+                tasks[i].fn = &vnut_scan_sum_task;
+                tasks[i].arg = &chunks[i];
+            }
+            cpool_run(pool, tasks, count);
+
+            for (i = 0U; i < count; i++) {
+                const vnut_u64 sum = chunks[i].carry;
+                chunks[i].carry = carry;
+                carry += sum;
+                tasks[i].fn = &vnut_scan_task;
+            }
+            cpool_run(pool, tasks, count);
+        }
+        else {
+            vnut_scan_task(&proto);
+        }
+
+        free(chunks);
+        free(tasks);
+    }
+}
+
+/**
+ * @brief Compute the inclusive prefix sum of a vector of integers:
+ *        dst[i] = src[0] + ... + src[i]
+ * @param[in] pool The pool executing the chunks, or NULL
+ * @param[out] dst A pointer to the destination vector, already initialized
+ *             with the same type size of \a src. It is resized to the size of
+ *             \a src (calling the error callback on failure)
+ * @param[in] src A pointer to the source vector. It can be \a dst itself.
+ *            Its elements must be signed or unsigned integers of 1, 2, 4 or 8
+ *            bytes, otherwise nothing is done. Overflows wrap around
+ * @note Large vectors are scanned in two passes: the first one sums every
+ *       chunk in parallel, the second one scans every chunk in parallel
+ *       starting from the sum of the previous chunks. Inside a chunk, 4 and 8
+ *       bytes integers are scanned with SSE2 instructions when available
+ */
+static void cvector_inclusive_scan(cpool_t* pool,
+                                   cvector_t* dst,
+                                   const cvector_t* src)
+{
+    vnut_scan(pool, dst, src, 1);
+}
+
+/**
+ * @brief Compute the exclusive prefix sum of a vector of integers:
+ *        dst[0] = 0 and dst[i] = src[0] + ... + src[i-1]
+ * @param[in] pool The pool executing the chunks, or NULL
+ * @param[out] dst A pointer to the destination vector, see
+ *             cvector_inclusive_scan()
+ * @param[in] src A pointer to the source vector, see cvector_inclusive_scan()
+ * @note This is typically used to turn sizes into offsets
+ */
+static void cvector_exclusive_scan(cpool_t* pool,
+                                   cvector_t* dst,
+                                   const cvector_t* src)
+{
+    vnut_scan(pool, dst, src, 0);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,82 @@
+/*
+clang -Ofast -oheap heap_bench.c
+gcc -Ofast -oheap heap_bench.c
+cl /O2 /Feheap heap_bench.c
+
+compare the times printed for the binary and the 4-ary heap on your env
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "cheap.h"
+
+#define HEAP_SIZE (1 << 20)
+#define UPDATE_LOOP (HEAP_SIZE * 4)
+
+#define UINT_LESS(a, b) ((a) < (b))
+
+CHEAP_DEFINE(heap2, unsigned int, UINT_LESS, 2)
+CHEAP_DEFINE(heap4, unsigned int, UINT_LESS, 4)
+
+static unsigned int seed = 1U;
+
+static unsigned int next_rand(void) {
+    seed = (seed * 1103515245U) + 12345U;
+    return seed;
+}
+
+#define RUN_BENCH(name, arity)                                               \
+    {                                                                        \
+        clock_t start;                                                       \
+        unsigned int prev = 0U;                                              \
+                                                                             \
+        seed = 1U;                                                           \
+        start = clock();                                                     \
+        for (i = 0; i < HEAP_SIZE; i++) {                                    \
+            const unsigned int x = next_rand();                              \
+            name##_push(pv, &x);                                             \
+        }                                                                    \
+        for (i = 0; i < UPDATE_LOOP; i++) {                                  \
+            const unsigned int x = *name##_top(pv) + (next_rand() >> 8);     \
+            name##_pop(pv);                                                  \
+            name##_push(pv, &x);                                             \
+        }                                                                    \
+        while (!cvector_empty(pv)) {                                         \
+            const unsigned int x = *name##_top(pv);                          \
+            if (x < prev) {                                                  \
+                puts("impossible");                                          \
+                exit(-1);                                                    \
+            }                                                                \
+            prev = x;                                                        \
+            name##_pop(pv);                                                  \
+        }                                                                    \
+        printf("%d-ary push/pop: %.3f s\n", arity,                           \
+               (double)(clock() - start) / CLOCKS_PER_SEC);                  \
+                                                                             \
+        for (i = 0; i < HEAP_SIZE; i++) {                                    \
+            const unsigned int x = next_rand();                              \
+            cvector_push_back(pv, &x);                                       \
+        }                                                                    \
+        start = clock();                                                     \
+        name##_heapify(pv);                                                  \
+        printf("%d-ary heapify:  %.3f s\n", arity,                           \
+               (double)(clock() - start) / CLOCKS_PER_SEC);                  \
+        cvector_clear(pv);                                                   \
+    }
+
+int main(void)
+{
+    cvector_t v;
+    cvector_t* pv = &v;
+    size_t i;
+
+    cvector_init(pv, sizeof(unsigned int), HEAP_SIZE, CVECTOR_DATA);
+
+    RUN_BENCH(heap2, 2)
+    RUN_BENCH(heap4, 4)
+
+    cvector_destroy(pv);
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+/*
+clang -Ofast -opf pf_bench.c
+clang -Ofast -opf0 -DCLIST_PREFETCH_DISTANCE=0 pf_bench.c
+
+gcc -Ofast -opf pf_bench.c
+gcc -Ofast -opf0 -DCLIST_PREFETCH_DISTANCE=0 pf_bench.c
+
+compare the times printed by both exe on your env: the second one does not
+prefetch. The list is much larger than the last level cache, and its nodes
+are scattered in memory by sorting random values, as after a long churn
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "cvector_clist.h"
+
+#define NUM_ELEMS (1 << 22)
+#define BENCH_LOOP 5
+
+static unsigned int seed = 1U;
+static unsigned int acc = 0U;
+
+static unsigned int next_rand(void) {
+    seed = (seed * 1103515245U) + 12345U;
+    return seed;
+}
+
+static int cmp_int(const void* a, const void* b) {
+    const int x = *(const int*)a;
+    const int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static void sum_cb(void* p) {
+    acc += *(unsigned int*)p;
+}
+
+static void mix_cb(void* p) {
+    unsigned int h = *(unsigned int*)p;
+    int k;
+    for (k = 0; k < 64; k++) {
+        h ^= h >> 15;
+        h *= 0x2c1b3c6dU;
+    }
+    acc += h;
+}
+
+static double now(void) {
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+int main(void)
+{
+    clist_t l;
+    cvector_t v;
+    double start;
+    int i;
+
+    clist_init(&l, sizeof(int), CLIST_PAYLOAD_IGNORE);
+    for (i = 0; i < NUM_ELEMS; i++) {
+        const int x = (int)(next_rand() >> 1);
+        clist_push_back(&l, &x);
+    }
+    clist_sort(&l, cmp_int);
+
+    printf("prefetch distance: %u\n", (unsigned int)CLIST_PREFETCH_DISTANCE);
+
+    start = now();
+    for (i = 0; i < BENCH_LOOP; i++) {
+        clist_foreach(&l, sum_cb);
+    }
+    printf("foreach, sum: %.3f s\n", now() - start);
+
+    start = now();
+    for (i = 0; i < BENCH_LOOP; i++) {
+        clist_foreach(&l, mix_cb);
+    }
+    printf("foreach, hash: %.3f s\n", now() - start);
+
+    cvector_init(&v, sizeof(int), NUM_ELEMS, CVECTOR_DATA);
+    start = now();
+    for (i = 0; i < BENCH_LOOP; i++) {
+        cvector_clear(&v);
+        cvector_from_clist(&v, &l);
+    }
+    printf("cvector_from_clist: %.3f s (%u)\n", now() - start, acc);
+
+    if ((v.n != l.size)
+        || (CVECTOR_ELEM(&v, 0U, int) != *CLIST_PTR(&l, 0U, int)))
+    {
+        puts("impossible");
+        exit(-1);
+    }
+
+    cvector_destroy(&v);
+    clist_destroy(&l);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,139 @@
+/*
+clang -Ofast -oscan scan_bench.c -lpthread
+gcc -Ofast -oscan scan_bench.c -lpthread
+
+compare the times printed for the scalar loop, the SIMD scan on one thread
+and the scan on the pool on your env. Every integer size is also checked
+against the scalar loop
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "cvector_par.h"
+
+#define NUM_ELEMS (1 << 24)
+#define SCAN_LOOP 10
+#define NUM_WORKERS 4U
+
+#define CHECK_SCAN(T, n)                                                     \
+    {                                                                        \
+        cvector_t src, dst;                                                  \
+        T* x;                                                                \
+        T* y;                                                                \
+        T c;                                                                 \
+        cv_ui j;                                                             \
+                                                                             \
+        cvector_init(&src, sizeof(T), n, CVECTOR_DATA);                      \
+        cvector_init(&dst, sizeof(T), CVECTOR_DEFAULT_LEN, CVECTOR_DATA);    \
+        cvector_resize(&src, n, NULL);                                       \
+        x = (T*)src.p;                                                       \
+        for (j = 0U; j < n; j++) {                                           \
+            x[j] = (T)(next_rand() >> 7);                                    \
+        }                                                                    \
+                                                                             \
+        cvector_exclusive_scan(&pool, &dst, &src);                           \
+        y = (T*)dst.p;                                                       \
+        for (c = 0, j = 0U; j < n; j++) {                                    \
+            if (y[j] != c) {                                                 \
+                puts("impossible");                                          \
+                exit(-1);                                                    \
+            }                                                                \
+            c = (T)(c + x[j]);                                               \
+        }                                                                    \
+                                                                             \
+        cvector_inclusive_scan(&pool, &dst, &src);                           \
+        y = (T*)dst.p;                                                       \
+        for (c = 0, j = 0U; j < n; j++) {                                    \
+            c = (T)(c + x[j]);                                               \
+            if (y[j] != c) {                                                 \
+                puts("impossible");                                          \
+                exit(-1);                                                    \
+            }                                                                \
+        }                                                                    \
+                                                                             \
+        cvector_inclusive_scan(NULL, &src, &src);                            \
+        if (memcmp(src.p, dst.p, n * sizeof(T)) != 0) {                      \
+            puts("impossible");                                              \
+            exit(-1);                                                        \
+        }                                                                    \
+                                                                             \
+        cvector_destroy(&dst);                                               \
+        cvector_destroy(&src);                                               \
+    }
+
+static unsigned int seed = 1U;
+
+static unsigned int next_rand(void) {
+    seed = (seed * 1103515245U) + 12345U;
+    return seed;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+int main(void)
+{
+    static const cv_ui sizes[] = { 0U, 1U, 7U, 1000U, 100003U, 3000017U };
+    cpool_t pool;
+    cvector_t src, dst;
+    unsigned int* x;
+    unsigned int* y;
+    unsigned int c;
+    double start;
+    cv_ui i;
+    int k;
+
+    if (cpool_init(&pool, NUM_WORKERS) != EXIT_SUCCESS) {
+        puts("cannot start the pool");
+        return EXIT_FAILURE;
+    }
+
+    for (i = 0U; i < (sizeof(sizes) / sizeof(sizes[0])); i++) {
+        CHECK_SCAN(unsigned char, sizes[i])
+        CHECK_SCAN(short, sizes[i])
+        CHECK_SCAN(unsigned int, sizes[i])
+        CHECK_SCAN(vnut_u64, sizes[i])
+    }
+
+    cvector_init(&src, sizeof(unsigned int), NUM_ELEMS, CVECTOR_DATA);
+    cvector_init(&dst, sizeof(unsigned int), NUM_ELEMS, CVECTOR_DATA);
+    cvector_resize(&src, NUM_ELEMS, NULL);
+    cvector_resize(&dst, NUM_ELEMS, NULL);
+    x = (unsigned int*)src.p;
+    y = (unsigned int*)dst.p;
+    for (i = 0U; i < NUM_ELEMS; i++) {
+        x[i] = next_rand() >> 16;
+    }
+
+    start = now();
+    for (k = 0; k < SCAN_LOOP; k++) {
+        for (c = 0U, i = 0U; i < NUM_ELEMS; i++) {
+            c += x[i];
+            y[i] = c;
+        }
+    }
+    printf("scalar loop: %.3f s (%u)\n", now() - start, y[NUM_ELEMS - 1]);
+
+    start = now();
+    for (k = 0; k < SCAN_LOOP; k++) {
+        cvector_inclusive_scan(NULL, &dst, &src);
+    }
+    printf("scan, 1 thread: %.3f s (%u)\n", now() - start, y[NUM_ELEMS - 1]);
+
+    start = now();
+    for (k = 0; k < SCAN_LOOP; k++) {
+        cvector_inclusive_scan(&pool, &dst, &src);
+    }
+    printf("scan, %u workers: %.3f s (%u)\n", cpool_size(&pool),
+           now() - start, y[NUM_ELEMS - 1]);
+
+    cvector_destroy(&dst);
+    cvector_destroy(&src);
+    cpool_destroy(&pool);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,89 @@
+/*
+clang -Ofast -oshm shm_bench.c -lpthread
+gcc -Ofast -oshm shm_bench.c -lpthread
+
+measure the throughput printed for each number of threads on your env.
+Each thread runs a mix of 90% lookups and 10% insertions on random keys
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "cshardmap.h"
+
+#define NUM_KEYS (1 << 20)
+#define OPS_PER_THREAD (1 << 22)
+#define MAX_THREADS 16
+#define SHARDS 64U
+
+static cshardmap_t map;
+
+static cv_ui hash_key(const void* key) {
+    return *(const size_t*)key;
+}
+
+static void* worker(void* arg) {
+    size_t seed = (size_t)arg * 2654435761UL + 1U;
+    size_t i, found = 0;
+
+    for (i = 0; i < OPS_PER_THREAD; i++) {
+        size_t key;
+
+        seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+        key = (seed >> 33) % NUM_KEYS;
+
+        if (((seed >> 20) % 10U) == 0U) {
+            (void)cshardmap_insert(&map, &key, &i);
+        }
+        else {
+            size_t value;
+            found += (size_t)cshardmap_find(&map, &key, &value);
+        }
+    }
+
+    return (void*)found;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+int main(void)
+{
+    pthread_t threads[MAX_THREADS];
+    size_t i, nthreads;
+
+    cshardmap_init(&map, SHARDS, sizeof(size_t), sizeof(size_t),
+                   CVECTOR_DEFAULT_LEN, &hash_key);
+
+    for (i = 0; i < NUM_KEYS; i += 2) {
+        (void)cshardmap_insert(&map, &i, &i);
+    }
+
+    for (nthreads = 1; nthreads <= MAX_THREADS; nthreads *= 2) {
+        const double start = now();
+        double elapsed;
+
+        for (i = 0; i < nthreads; i++) {
+            pthread_create(&threads[i], NULL, &worker, (void*)(i + 1));
+        }
+        for (i = 0; i < nthreads; i++) {
+            pthread_join(threads[i], NULL);
+        }
+
+        elapsed = now() - start;
+        printf("%2u threads: %.2f Mops/s\n", (unsigned int)nthreads,
+               ((double)nthreads * OPS_PER_THREAD) / elapsed / 1e6);
+    }
+
+    if (cshardmap_size(&map) < (NUM_KEYS / 2)) {
+        puts("impossible");
+        exit(-1);
+    }
+
+    cshardmap_destroy(&map);
+
+    return 0;
+}